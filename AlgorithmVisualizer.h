@@ -5,15 +5,15 @@
 #include <SFML/Graphics.hpp>
 #include "Graph.h"
 #include "PathFinder.h"
-#include "LinkedList.h"
+#include "ArrayList.h"
 #include <cmath>
 #include <sstream>
 #include <string>
 using namespace std;
 struct AlgorithmStep {
     int currentPortIdx;
-    LinkedList<int> visitedPorts;
-    LinkedList<int> updatedPorts;
+    ArrayList<int> visitedPorts;
+    ArrayList<int> updatedPorts;
     int* distances;
     int* parents;
     bool* visited;
@@ -35,7 +35,7 @@ private:
     bool isVisualizing;
     bool isPaused;
     int currentStep;
-    LinkedList<AlgorithmStep> steps;
+    ArrayList<AlgorithmStep> steps;
     PortMapper* portMapper;
     string origin;
     string destination;
@@ -170,7 +170,7 @@ private:
     }
 
     void drawAllRoutesDimmed(sf::RenderWindow& window) {
-        LinkedList<Route> allRoutes = graph->getAllRoutes();
+        Graph::RouteView allRoutes = graph->getAllRoutes();
         for (int i = 0; i < allRoutes.getSize(); i++) {
             const Route& route = allRoutes.get(i);
             Port originPort, destPort;
@@ -0,0 +1,216 @@
+#pragma once
+#ifndef ARRAYLIST_H
+#define ARRAYLIST_H
+#include <utility>
+// Read-only window onto contiguous elements (an ArrayList or part of one).
+// Cheap to copy; only valid while the list it points into is unchanged.
+template <typename T>
+class ArrayView
+{
+private:
+    const T *items;
+    int size;
+
+public:
+    ArrayView() : items(nullptr), size(0) {}
+    ArrayView(const T *first, int count) : items(first), size(count) {}
+
+    const T &get(int index) const { return items[index]; }
+    const T &operator[](int index) const { return items[index]; }
+    int getSize() const { return size; }
+    bool isEmpty() const { return size == 0; }
+    const T *begin() const { return items; }
+    const T *end() const { return items + size; }
+};
+
+// Growable contiguous array with the LinkedList interface. get(i) is O(1),
+// so the usual "for (i < getSize()) get(i)" loops stay linear; push_front
+// and remove shift elements, so prefer push_back where order allows.
+template <typename T>
+class ArrayList
+{
+private:
+    T *items;
+    int size;
+    int capacity;
+
+    void grow(int minCapacity)
+    {
+        int newCapacity = (capacity == 0) ? 8 : capacity * 2;
+        if (newCapacity < minCapacity)
+        {
+            newCapacity = minCapacity;
+        }
+        T *newItems = new T[newCapacity];
+        for (int i = 0; i < size; i++)
+        {
+            newItems[i] = std::move(items[i]);
+        }
+        delete[] items;
+        items = newItems;
+        capacity = newCapacity;
+    }
+
+public:
+    ArrayList() : items(nullptr), size(0), capacity(0) {}
+    ArrayList(const ArrayList &other) : items(nullptr), size(0), capacity(0)
+    {
+        reserve(other.size);
+        for (int i = 0; i < other.size; i++)
+        {
+            items[i] = other.items[i];
+        }
+        size = other.size;
+    }
+    ArrayList(ArrayList &&other) : items(other.items), size(other.size), capacity(other.capacity)
+    {
+        other.items = nullptr;
+        other.size = 0;
+        other.capacity = 0;
+    }
+    ArrayList &operator=(const ArrayList &other)
+    {
+        if (this != &other)
+        {
+            clear();
+            reserve(other.size);
+            for (int i = 0; i < other.size; i++)
+            {
+                items[i] = other.items[i];
+            }
+            size = other.size;
+        }
+        return *this;
+    }
+    ArrayList &operator=(ArrayList &&other)
+    {
+        if (this != &other)
+        {
+            delete[] items;
+            items = other.items;
+            size = other.size;
+            capacity = other.capacity;
+            other.items = nullptr;
+            other.size = 0;
+            other.capacity = 0;
+        }
+        return *this;
+    }
+    ~ArrayList()
+    {
+        delete[] items;
+    }
+    // Make room for count elements without further reallocation
+    void reserve(int count)
+    {
+        if (count > capacity)
+        {
+            grow(count);
+        }
+    }
+    void push_back(const T &value)
+    {
+        if (size >= capacity)
+        {
+            // value may live in this list, so copy it before growing
+            T copy(value);
+            grow(size + 1);
+            items[size++] = std::move(copy);
+            return;
+        }
+        items[size++] = value;
+    }
+    void push_back(T &&value)
+    {
+        if (size >= capacity)
+        {
+            grow(size + 1);
+        }
+        items[size++] = std::move(value);
+    }
+    void push_front(const T &value)
+    {
+        T copy(value);
+        if (size >= capacity)
+        {
+            grow(size + 1);
+        }
+        for (int i = size; i > 0; i--)
+        {
+            items[i] = std::move(items[i - 1]);
+        }
+        items[0] = std::move(copy);
+        size++;
+    }
+    void pop_back()
+    {
+        if (size > 0)
+        {
+            items[--size] = T();
+        }
+    }
+    bool remove(int index)
+    {
+        if (index < 0 || index >= size)
+            return false;
+        for (int i = index; i < size - 1; i++)
+        {
+            items[i] = std::move(items[i + 1]);
+        }
+        items[--size] = T();
+        return true;
+    }
+    // Reverse in place (for paths built back to front with push_back)
+    void reverse()
+    {
+        for (int i = 0, j = size - 1; i < j; i++, j--)
+        {
+            std::swap(items[i], items[j]);
+        }
+    }
+    T &get(int index)
+    {
+        // SAFETY CHECK: Prevents crash
+        if (index < 0 || index >= size)
+        {
+            static T dummy;
+            return dummy;
+        }
+        return items[index];
+    }
+    const T &get(int index) const
+    {
+        // SAFETY CHECK: Prevents crash
+        if (index < 0 || index >= size)
+        {
+            static T dummy;
+            return dummy;
+        }
+        return items[index];
+    }
+    // Unchecked access for loops that already know the bounds
+    T &operator[](int index) { return items[index]; }
+    const T &operator[](int index) const { return items[index]; }
+    int getSize() const { return size; }
+    int getCapacity() const { return capacity; }
+    bool isEmpty() const { return size == 0; }
+    // Drop every element but keep the storage for reuse
+    void clear()
+    {
+        for (int i = 0; i < size; i++)
+        {
+            items[i] = T();
+        }
+        size = 0;
+    }
+    T *data() { return items; }
+    const T *data() const { return items; }
+    ArrayView<T> view() const { return ArrayView<T>(items, size); }
+    ArrayView<T> view(int first, int count) const { return ArrayView<T>(items + first, count); }
+    // Iterator support for range-based for loops
+    T *begin() { return items; }
+    T *end() { return items + size; }
+    const T *begin() const { return items; }
+    const T *end() const { return items + size; }
+};
+#endif
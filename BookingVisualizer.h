@@ -5,7 +5,7 @@
 #include <SFML/Graphics.hpp>
 #include "Graph.h"
 #include "PathFinder.h"
-#include "LinkedList.h"
+#include "ArrayList.h"
 #include <cmath>
 #include <sstream>
 using namespace std;
@@ -27,17 +27,17 @@ private:
 
     // Current path being displayed
     PathResult currentPath;
-    LinkedList<Route> displayRoutes;   // Connecting routes (highlighted)
-    LinkedList<Route> allRoutes;       // All routes in graph
-    LinkedList<string> importantPorts; // Ports that are part of connecting routes
+    ArrayList<Route> displayRoutes;   // Connecting routes (highlighted)
+    ArrayList<Route> allRoutes;       // All routes in graph
+    ArrayList<string> importantPorts; // Ports that are part of connecting routes
     string origin;
     string destination;
     bool showAllRoutes; // Whether to show all routes or just connecting ones
 
     // Algorithm step visualization
     bool showAlgorithmSteps;
-    LinkedList<string> visitedPorts;    // Ports visited during algorithm
-    LinkedList<string> processingPorts; // Ports currently being processed
+    ArrayList<string> visitedPorts;    // Ports visited during algorithm
+    ArrayList<string> processingPorts; // Ports currently being processed
     string currentProcessingPort;       // Current port being processed
 
     const float PORT_RADIUS = 10.0f;
@@ -50,8 +50,12 @@ public:
     {
     }
 
+    // Draw a different graph (schedule reload); a path on screen keeps its
+    // own copies of the routes, so it finishes as it was found
+    void setGraph(Graph *g) { graph = g; }
+
     // Set algorithm step visualization data
-    void setAlgorithmSteps(const LinkedList<string> &visited, const LinkedList<string> &processing,
+    void setAlgorithmSteps(const ArrayList<string> &visited, const ArrayList<string> &processing,
                            const string &current)
     {
         visitedPorts = visited;
@@ -88,7 +92,7 @@ public:
     }
 
     void showConnectingRoutes(const string &orig, const string &dest,
-                              const LinkedList<Route> &routes, const string &date = "")
+                              const ArrayList<Route> &routes, const string &date = "")
     {
         origin = orig;
         destination = dest;
@@ -100,7 +104,7 @@ public:
         if (!date.empty())
         {
             allRoutes.clear();
-            LinkedList<Route> allGraphRoutes = graph->getAllRoutes();
+            Graph::RouteView allGraphRoutes = graph->getAllRoutes();
             for (int i = 0; i < allGraphRoutes.getSize(); i++)
             {
                 if (allGraphRoutes.get(i).date == date)
@@ -111,7 +115,7 @@ public:
         }
         else
         {
-            allRoutes = graph->getAllRoutes();
+            allRoutes = graph->getAllRoutes().toList();
         }
 
         // Build set of important ports (ports that are part of connecting routes)
@@ -151,7 +155,7 @@ public:
     }
 
     // Update connecting routes (for real-time updates in option 3)
-    void updateConnectingRoutes(const LinkedList<Route> &routes, const string &date = "")
+    void updateConnectingRoutes(const ArrayList<Route> &routes, const string &date = "")
     {
         displayRoutes = routes;
 
@@ -159,7 +163,7 @@ public:
         if (!date.empty())
         {
             allRoutes.clear();
-            LinkedList<Route> allGraphRoutes = graph->getAllRoutes();
+            Graph::RouteView allGraphRoutes = graph->getAllRoutes();
             for (int i = 0; i < allGraphRoutes.getSize(); i++)
             {
                 if (allGraphRoutes.get(i).date == date)
@@ -332,7 +336,7 @@ private:
     void drawHighlightedPorts(sf::RenderWindow &window)
     {
         // Use simple array to track drawn ports (NO HASHTABLE!)
-        LinkedList<string> portsDrawn;
+        ArrayList<string> portsDrawn;
 
         for (int i = 0; i < displayRoutes.getSize(); i++)
         {
@@ -649,7 +653,7 @@ private:
     // Draw all ports with highlighting
     void drawAllPorts(sf::RenderWindow &window)
     {
-        LinkedList<Port> allPorts = graph->getAllPorts();
+        ArrayList<Port> allPorts = graph->getAllPorts();
 
         for (int i = 0; i < allPorts.getSize(); i++)
         {
@@ -0,0 +1,396 @@
+#pragma once
+#ifndef CONNECTION_SCANNER_H
+#define CONNECTION_SCANNER_H
+
+#include "TimeDependentRouter.h"
+#include "SearchWorkspace.h"
+#include <limits>
+using namespace std;
+// Connection Scan queries over the whole timetable.
+//
+// Every sailing is copied once into a flat array sorted by departure stamp.
+// A query is then a single pass over that array (forwards for arrival and
+// cost queries, backwards for profiles) with no priority queue: a sailing
+// can only feed sailings that depart after it, and those come later in the
+// array. The copy is refreshed by the first query after the graph's
+// timetable changes (new routes or Graph::addSailing etc.); rebuild() does
+// it right away.
+class ConnectionScanner
+{
+public:
+    // One sailing of the flat timetable
+    struct Connection
+    {
+        int from;       // Origin port ID
+        int to;         // Destination port ID (-1 if the port is unknown)
+        int departure;  // Route::departureStamp
+        int arrival;    // Route::arrivalStamp
+        int cost;
+        int routeIndex; // See Graph::getRouteByIndex
+    };
+
+private:
+    Graph *graph;
+    Connection *connections;
+    int connectionCount;
+    int portCount;
+    int builtVersion; // Graph::getTimetableVersion() the copy was taken at
+    SearchWorkspace workspace; // Per-port and per-connection arrays reused across queries
+
+    // First connection departing at or after stamp
+    int lowerBound(int stamp) const
+    {
+        int lo = 0;
+        int hi = connectionCount;
+        while (lo < hi)
+        {
+            int mid = lo + (hi - lo) / 2;
+            if (connections[mid].departure < stamp)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    // Earliest profile entry of a port leaving at or after stamp. Entries are
+    // linked earliest departure first, and a later departure always arrives
+    // later, so the first one that is not too early arrives soonest.
+    static int firstEntryAfter(const StampedArray<int> &profileHead, const StampedArray<int> &entryDeparture,
+                               const StampedArray<int> &entryNext, int port, int stamp)
+    {
+        int e = profileHead.get(port);
+        while (e != -1 && entryDeparture.get(e) < stamp)
+        {
+            e = entryNext.get(e);
+        }
+        return e;
+    }
+
+public:
+    ConnectionScanner(Graph *g) : graph(g), connections(nullptr), connectionCount(0), portCount(0), builtVersion(-1)
+    {
+        rebuild();
+    }
+
+    ~ConnectionScanner()
+    {
+        delete[] connections;
+    }
+
+    ConnectionScanner(const ConnectionScanner &) = delete;
+    ConnectionScanner &operator=(const ConnectionScanner &) = delete;
+
+    // Re-copy the timetable from the graph (the graph keeps its routes in
+    // departure order, so no sorting happens here)
+    void rebuild()
+    {
+        delete[] connections;
+        builtVersion = graph->getTimetableVersion();
+        connectionCount = graph->getRouteCount();
+        portCount = graph->getVertexCount();
+        connections = new Connection[connectionCount > 0 ? connectionCount : 1];
+
+        for (int rank = 0; rank < connectionCount; rank++)
+        {
+            int routeIndex = graph->getRouteByDepartureRank(rank);
+            const Route &route = graph->getRouteByIndex(routeIndex);
+            Connection &c = connections[rank];
+            c.from = graph->getRouteOriginId(routeIndex);
+            c.to = graph->getPortId(route.destination);
+            c.departure = route.departureStamp;
+            c.arrival = route.arrivalStamp;
+            c.cost = route.cost;
+            c.routeIndex = routeIndex;
+        }
+    }
+
+    // Rebuild if the graph's timetable changed since the last copy
+    void refresh()
+    {
+        if (builtVersion != graph->getTimetableVersion())
+        {
+            rebuild();
+        }
+    }
+
+    // Scan a different graph's timetable (schedule reload)
+    void setGraph(Graph *g)
+    {
+        graph = g;
+        rebuild();
+    }
+
+    int getConnectionCount() const { return connectionCount; }
+    const Connection &getConnection(int index) const { return connections[index]; }
+
+    // Earliest arrival at destination leaving origin at or after departAfter
+    PathResult findEarliestArrival(const string &origin, const string &destination, int departAfter)
+    {
+        refresh();
+        PathResult result;
+
+        int originIdx = graph->getPortId(origin);
+        int destIdx = graph->getPortId(destination);
+        if (originIdx == -1 || destIdx == -1)
+        {
+            return result;
+        }
+        if (originIdx == destIdx)
+        {
+            result.found = true;
+            result.path.push_back(origin);
+            return result;
+        }
+
+        StampedArray<int> &earliest = workspace.ints(0, portCount, numeric_limits<int>::max());
+        StampedArray<int> &reachedBy = workspace.ints(1, portCount, -1); // Connection that first reached each port
+        earliest[originIdx] = departAfter;
+
+        for (int k = lowerBound(departAfter); k < connectionCount; k++)
+        {
+            const Connection &c = connections[k];
+            if (c.departure >= earliest[destIdx])
+                break; // Anything leaving now or later arrives later
+            if (c.to == -1 || earliest[c.from] > c.departure || c.arrival >= earliest[c.to])
+                continue;
+
+            earliest[c.to] = c.arrival;
+            reachedBy[c.to] = k;
+        }
+
+        if (reachedBy[destIdx] != -1)
+        {
+            ArrayList<int> chain;
+            for (int port = destIdx; port != originIdx; port = connections[reachedBy[port]].from)
+            {
+                chain.push_back(connections[reachedBy[port]].routeIndex);
+            }
+            chain.reverse();
+            TimeDependentRouter::buildResult(*graph, origin, chain, result);
+        }
+
+        return result;
+    }
+
+    PathResult findEarliestArrival(const string &origin, const string &destination, const string &date)
+    {
+        return findEarliestArrival(origin, destination, Route::toTimestamp(date, "00:00"));
+    }
+
+    // Cheapest voyage (sailing costs plus port charges for layovers > 12h)
+    // leaving origin at or after departAfter. Same cost model and answer as
+    // TimeDependentRouter::findCheapestByDeadline with no deadline.
+    //
+    // Each connection is labelled with the cheapest voyage that ends with it.
+    // Labelled connections are linked per arrival port, latest arrival first;
+    // when a sailing is scanned, an arrival that is no cheaper than a later
+    // (and also usable) one is unlinked, since it waits longer for this and
+    // every later sailing.
+    PathResult findCheapestPath(const string &origin, const string &destination, int departAfter)
+    {
+        refresh();
+        PathResult result;
+
+        int originIdx = graph->getPortId(origin);
+        int destIdx = graph->getPortId(destination);
+        if (originIdx == -1 || destIdx == -1)
+        {
+            return result;
+        }
+        if (originIdx == destIdx)
+        {
+            result.found = true;
+            result.path.push_back(origin);
+            return result;
+        }
+
+        StampedArray<int> &cost = workspace.ints(0, connectionCount, numeric_limits<int>::max());
+        StampedArray<int> &previous = workspace.ints(1, connectionCount, -1);
+        StampedArray<int> &nextArrival = workspace.ints(2, connectionCount, -1);
+        StampedArray<int> &arrivalHead = workspace.ints(3, portCount, -1);
+
+        int bestCost = numeric_limits<int>::max();
+        int bestConnection = -1;
+
+        for (int k = lowerBound(departAfter); k < connectionCount; k++)
+        {
+            const Connection &c = connections[k];
+            if (c.to == -1 || c.from == destIdx)
+                continue;
+
+            int cheapest = numeric_limits<int>::max();
+            int via = -1;
+            if (c.from == originIdx)
+            {
+                cheapest = c.cost; // No port charge at the origin
+            }
+
+            const Port &layoverPort = graph->getPortById(c.from);
+            int laterCost = numeric_limits<int>::max(); // Cheapest usable arrival seen so far
+            int *link = &arrivalHead[c.from];
+            while (*link != -1)
+            {
+                int a = *link;
+                if (connections[a].arrival > c.departure)
+                {
+                    link = &nextArrival[a]; // Still at sea
+                    continue;
+                }
+                if (cost[a] >= laterCost)
+                {
+                    *link = nextArrival[a]; // Dominated from now on
+                    continue;
+                }
+                laterCost = cost[a];
+
+                int layoverHours = (c.departure - connections[a].arrival) / 60;
+                int total = cost[a] + TimeDependentRouter::layoverCharge(layoverPort, layoverHours) + c.cost;
+                if (total < cheapest)
+                {
+                    cheapest = total;
+                    via = a;
+                }
+                link = &nextArrival[a];
+            }
+
+            // Costs never go down along a voyage
+            if (cheapest >= bestCost)
+                continue;
+
+            cost[k] = cheapest;
+            previous[k] = via;
+            if (c.to == destIdx)
+            {
+                bestCost = cheapest;
+                bestConnection = k;
+                continue;
+            }
+
+            link = &arrivalHead[c.to];
+            while (*link != -1 && connections[*link].arrival > c.arrival)
+            {
+                link = &nextArrival[*link];
+            }
+            nextArrival[k] = *link;
+            *link = k;
+        }
+
+        if (bestConnection != -1)
+        {
+            ArrayList<int> chain;
+            for (int k = bestConnection; k != -1; k = previous[k])
+            {
+                chain.push_back(connections[k].routeIndex);
+            }
+            chain.reverse();
+            TimeDependentRouter::buildResult(*graph, origin, chain, result);
+        }
+
+        return result;
+    }
+
+    PathResult findCheapestPath(const string &origin, const string &destination, const string &date)
+    {
+        return findCheapestPath(origin, destination, Route::toTimestamp(date, "00:00"));
+    }
+
+    // Profile query: every Pareto-optimal voyage from origin to destination
+    // leaving between windowStart and windowEnd, in departure order. Each one
+    // leaves later than the previous and still arrives earlier than any
+    // voyage leaving at or after it, e.g. "all useful departures this week".
+    //
+    // One backward scan builds, for every port, the list of (departure,
+    // arrival) options towards the destination; the origin's list is the
+    // answer. Sailings after windowEnd are still scanned so that voyages
+    // leaving inside the window may finish after it.
+    ArrayList<PathResult> findParetoDepartures(const string &origin, const string &destination,
+                                                int windowStart, int windowEnd)
+    {
+        refresh();
+        ArrayList<PathResult> results;
+
+        int originIdx = graph->getPortId(origin);
+        int destIdx = graph->getPortId(destination);
+        if (originIdx == -1 || destIdx == -1 || originIdx == destIdx)
+        {
+            return results;
+        }
+
+        // At most one profile entry per scanned connection; entries are
+        // written before they are read
+        StampedArray<int> &entryDeparture = workspace.ints(0, connectionCount, 0);
+        StampedArray<int> &entryArrival = workspace.ints(1, connectionCount, 0);
+        StampedArray<int> &entryConnection = workspace.ints(2, connectionCount, -1);
+        StampedArray<int> &entryNext = workspace.ints(3, connectionCount, -1);
+        StampedArray<int> &profileHead = workspace.ints(4, portCount, -1);
+        int entryCount = 0;
+
+        int first = lowerBound(windowStart);
+        for (int k = connectionCount - 1; k >= first; k--)
+        {
+            const Connection &c = connections[k];
+            if (c.to == -1 || c.from == destIdx)
+                continue;
+
+            int arrival = c.arrival;
+            if (c.to != destIdx)
+            {
+                int e = firstEntryAfter(profileHead, entryDeparture, entryNext, c.to, c.arrival);
+                if (e == -1)
+                    continue;
+                arrival = entryArrival[e];
+            }
+
+            // The head leaves no earlier than c, so c must beat its arrival
+            int head = profileHead[c.from];
+            if (head != -1 && entryArrival[head] <= arrival)
+                continue;
+
+            if (head != -1 && entryDeparture[head] == c.departure)
+            {
+                entryArrival[head] = arrival;
+                entryConnection[head] = k;
+            }
+            else
+            {
+                int e = entryCount++;
+                entryDeparture[e] = c.departure;
+                entryArrival[e] = arrival;
+                entryConnection[e] = k;
+                entryNext[e] = head;
+                profileHead[c.from] = e;
+            }
+        }
+
+        for (int e = profileHead[originIdx]; e != -1 && entryDeparture[e] <= windowEnd; e = entryNext[e])
+        {
+            ArrayList<int> chain;
+            int k = entryConnection[e];
+            while (true)
+            {
+                chain.push_back(connections[k].routeIndex);
+                if (connections[k].to == destIdx)
+                    break;
+                int next = firstEntryAfter(profileHead, entryDeparture, entryNext,
+                                           connections[k].to, connections[k].arrival);
+                k = entryConnection[next];
+            }
+
+            PathResult result;
+            TimeDependentRouter::buildResult(*graph, origin, chain, result);
+            results.push_back(result);
+        }
+
+        return results;
+    }
+
+    ArrayList<PathResult> findParetoDepartures(const string &origin, const string &destination,
+                                                const string &fromDate, const string &toDate)
+    {
+        return findParetoDepartures(origin, destination, Route::toTimestamp(fromDate, "00:00"),
+                                    Route::toTimestamp(toDate, "23:59"));
+    }
+};
+
+#endif
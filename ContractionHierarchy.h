@@ -0,0 +1,585 @@
+#pragma once
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include "Graph.h"
+#include "IndexedMinHeap.h"
+#include <limits>
+using namespace std;
+// Contraction hierarchy over the static lane graph (the cheapest sailing
+// for every ordered pair of ports, ignoring dates and port charges), for
+// bulk "cheapest lane" estimates when quoting.
+//
+// build() removes ports one at a time, least important first, adding a
+// shortcut u -> w around a removed port v whenever u -> v -> w was the
+// only cheapest way between them (checked with a small witness search).
+// A query then runs two Dijkstras that only climb to more important
+// ports and meet at the top, touching a few dozen ports instead of the
+// whole network. Optional: nothing is built until the first query (or
+// build()), and a query after the graph's sailings changed rebuilds it
+// first.
+class ContractionHierarchy
+{
+public:
+    static const int UNREACHABLE = numeric_limits<int>::max();
+
+private:
+    struct Arc
+    {
+        int target;
+        int cost;
+        int middle; // Port a shortcut bypasses, -1 for a real lane
+    };
+
+    // Growable arc array used while contracting
+    struct ArcList
+    {
+        Arc *items;
+        int size;
+        int capacity;
+
+        ArcList() : items(nullptr), size(0), capacity(0) {}
+        ~ArcList() { delete[] items; }
+        ArcList(const ArcList &) = delete;
+        ArcList &operator=(const ArcList &) = delete;
+
+        int find(int target) const
+        {
+            for (int i = 0; i < size; i++)
+            {
+                if (items[i].target == target)
+                    return i;
+            }
+            return -1;
+        }
+
+        void push_back(int target, int cost, int middle)
+        {
+            if (size >= capacity)
+            {
+                capacity = (capacity == 0) ? 4 : capacity * 2;
+                Arc *newItems = new Arc[capacity];
+                for (int i = 0; i < size; i++)
+                {
+                    newItems[i] = items[i];
+                }
+                delete[] items;
+                items = newItems;
+            }
+            items[size].target = target;
+            items[size].cost = cost;
+            items[size].middle = middle;
+            size++;
+        }
+
+        // Keep the cheaper of an existing arc and a new one
+        void relax(int target, int cost, int middle)
+        {
+            int i = find(target);
+            if (i == -1)
+            {
+                push_back(target, cost, middle);
+            }
+            else if (cost < items[i].cost)
+            {
+                items[i].cost = cost;
+                items[i].middle = middle;
+            }
+        }
+    };
+
+    const Graph *graph;
+    int builtVersion; // Graph::getTimetableVersion() at build()
+    int portCount;
+    int shortcutCount;
+    int *rank; // Contraction order, higher = more important
+
+    // Search graphs in CSR form: upArcs are arcs u -> w with rank[w] > rank[u],
+    // stored at u; downArcs are arcs x -> u with rank[x] > rank[u], stored at
+    // u and pointing back at x
+    int *upOffsets;
+    Arc *upArcs;
+    int *downOffsets;
+    Arc *downArcs;
+
+    // Query state reused across queries; only touched entries are reset
+    int *forwardDist;
+    int *backwardDist;
+    int *forwardParent;
+    int *backwardParent;
+    int *touched;
+    int touchedCount;
+    IndexedMinHeap<int> forward;
+    IndexedMinHeap<int> backward;
+
+    void release()
+    {
+        delete[] rank;
+        delete[] upOffsets;
+        delete[] upArcs;
+        delete[] downOffsets;
+        delete[] downArcs;
+        delete[] forwardDist;
+        delete[] backwardDist;
+        delete[] forwardParent;
+        delete[] backwardParent;
+        delete[] touched;
+        rank = nullptr;
+        upOffsets = nullptr;
+        upArcs = nullptr;
+        downOffsets = nullptr;
+        downArcs = nullptr;
+        forwardDist = nullptr;
+        backwardDist = nullptr;
+        forwardParent = nullptr;
+        backwardParent = nullptr;
+        touched = nullptr;
+        portCount = 0;
+        shortcutCount = 0;
+    }
+
+    // Dijkstra from source over uncontracted ports, never entering skip,
+    // stopping past maxCost or after settleLimit ports. Distances of every
+    // port it reached are left in dist and listed in reached.
+    static int witnessSearch(int source, int skip, int maxCost, int settleLimit,
+                             const ArcList *out, const bool *contracted,
+                             int *dist, int *reached, IndexedMinHeap<int> &frontier)
+    {
+        int reachedCount = 0;
+        dist[source] = 0;
+        reached[reachedCount++] = source;
+        frontier.pushOrDecrease(source, 0);
+
+        int settled = 0;
+        int port, portDist;
+        while (frontier.extractMin(port, portDist))
+        {
+            if (portDist > maxCost || ++settled > settleLimit)
+                break;
+            for (int i = 0; i < out[port].size; i++)
+            {
+                const Arc &arc = out[port].items[i];
+                if (arc.target == skip || contracted[arc.target])
+                    continue;
+                int newDist = portDist + arc.cost;
+                if (dist[arc.target] == UNREACHABLE)
+                {
+                    reached[reachedCount++] = arc.target;
+                }
+                else if (newDist >= dist[arc.target])
+                {
+                    continue;
+                }
+                dist[arc.target] = newDist;
+                frontier.pushOrDecrease(arc.target, newDist);
+            }
+        }
+        frontier.clear();
+        return reachedCount;
+    }
+
+    // Shortcuts needed to remove v; added to the graph when apply is set
+    int contract(int v, bool apply, ArcList *out, ArcList *in, const bool *contracted,
+                 int *dist, int *reached, IndexedMinHeap<int> &frontier)
+    {
+        const int settleLimit = 64;
+        int shortcuts = 0;
+
+        for (int i = 0; i < in[v].size; i++)
+        {
+            int u = in[v].items[i].target;
+            if (contracted[u])
+                continue;
+            int toV = in[v].items[i].cost;
+
+            int maxCost = 0;
+            for (int j = 0; j < out[v].size; j++)
+            {
+                int w = out[v].items[j].target;
+                if (!contracted[w] && w != u && toV + out[v].items[j].cost > maxCost)
+                    maxCost = toV + out[v].items[j].cost;
+            }
+
+            int reachedCount = witnessSearch(u, v, maxCost, settleLimit, out, contracted, dist, reached, frontier);
+            for (int j = 0; j < out[v].size; j++)
+            {
+                int w = out[v].items[j].target;
+                if (contracted[w] || w == u)
+                    continue;
+                int viaV = toV + out[v].items[j].cost;
+                if (dist[w] <= viaV)
+                    continue; // A path avoiding v is no dearer
+
+                shortcuts++;
+                if (apply)
+                {
+                    out[u].relax(w, viaV, v);
+                    in[w].relax(u, viaV, v);
+                }
+            }
+            for (int k = 0; k < reachedCount; k++)
+            {
+                dist[reached[k]] = UNREACHABLE;
+            }
+        }
+        return shortcuts;
+    }
+
+    // Search graph arc from a to b (the pair is unique after build)
+    const Arc *findArc(int a, int b) const
+    {
+        if (rank[a] < rank[b])
+        {
+            for (int i = upOffsets[a]; i < upOffsets[a + 1]; i++)
+            {
+                if (upArcs[i].target == b)
+                    return &upArcs[i];
+            }
+        }
+        else
+        {
+            for (int i = downOffsets[b]; i < downOffsets[b + 1]; i++)
+            {
+                if (downArcs[i].target == a)
+                    return &downArcs[i];
+            }
+        }
+        return nullptr;
+    }
+
+    // Append the ports after a on the lane a -> b, expanding shortcuts
+    void unpack(int a, int b, ArrayList<int> &ports) const
+    {
+        const Arc *arc = findArc(a, b);
+        if (arc == nullptr || arc->middle == -1)
+        {
+            ports.push_back(b);
+            return;
+        }
+        unpack(a, arc->middle, ports);
+        unpack(arc->middle, b, ports);
+    }
+
+    void touch(int port)
+    {
+        if (forwardDist[port] == UNREACHABLE && backwardDist[port] == UNREACHABLE)
+        {
+            touched[touchedCount++] = port;
+        }
+    }
+
+    // Bidirectional upward search; returns the cost and the meeting port
+    int search(int from, int to, int &meeting)
+    {
+        for (int i = 0; i < touchedCount; i++)
+        {
+            forwardDist[touched[i]] = UNREACHABLE;
+            backwardDist[touched[i]] = UNREACHABLE;
+        }
+        touchedCount = 0;
+
+        meeting = -1;
+        int best = UNREACHABLE;
+        forward.clear();
+        backward.clear();
+
+        touch(from);
+        forwardDist[from] = 0;
+        forwardParent[from] = -1;
+        forward.pushOrDecrease(from, 0);
+        touch(to);
+        backwardDist[to] = 0;
+        backwardParent[to] = -1;
+        backward.pushOrDecrease(to, 0);
+
+        bool forwardDone = false, backwardDone = false;
+        while (!forwardDone || !backwardDone)
+        {
+            for (int direction = 0; direction < 2; direction++)
+            {
+                bool isForward = (direction == 0);
+                if (isForward ? forwardDone : backwardDone)
+                    continue;
+
+                IndexedMinHeap<int> &frontier = isForward ? forward : backward;
+                int *dist = isForward ? forwardDist : backwardDist;
+                int *otherDist = isForward ? backwardDist : forwardDist;
+                int *parent = isForward ? forwardParent : backwardParent;
+                const int *offsets = isForward ? upOffsets : downOffsets;
+                const Arc *arcs = isForward ? upArcs : downArcs;
+
+                int port, portDist;
+                if (!frontier.extractMin(port, portDist) || portDist >= best)
+                {
+                    (isForward ? forwardDone : backwardDone) = true;
+                    continue;
+                }
+                if (otherDist[port] != UNREACHABLE && portDist + otherDist[port] < best)
+                {
+                    best = portDist + otherDist[port];
+                    meeting = port;
+                }
+
+                for (int i = offsets[port]; i < offsets[port + 1]; i++)
+                {
+                    int next = arcs[i].target;
+                    int newDist = portDist + arcs[i].cost;
+                    if (newDist < dist[next])
+                    {
+                        touch(next);
+                        dist[next] = newDist;
+                        parent[next] = port;
+                        frontier.pushOrDecrease(next, newDist);
+                    }
+                }
+            }
+        }
+        return best;
+    }
+
+public:
+    ContractionHierarchy(const Graph *g)
+        : graph(g), builtVersion(-1), portCount(0), shortcutCount(0), rank(nullptr),
+          upOffsets(nullptr), upArcs(nullptr), downOffsets(nullptr), downArcs(nullptr),
+          forwardDist(nullptr), backwardDist(nullptr), forwardParent(nullptr), backwardParent(nullptr),
+          touched(nullptr), touchedCount(0), forward(1), backward(1) {}
+
+    ~ContractionHierarchy()
+    {
+        release();
+    }
+
+    ContractionHierarchy(const ContractionHierarchy &) = delete;
+    ContractionHierarchy &operator=(const ContractionHierarchy &) = delete;
+
+    bool isBuilt() const { return rank != nullptr; }
+    // False once the graph's sailings changed after build(); the next query
+    // rebuilds
+    bool isCurrent() const { return isBuilt() && builtVersion == graph->getTimetableVersion(); }
+
+    // Rebuild if never built or the graph's sailings changed since
+    void refresh()
+    {
+        if (!isCurrent())
+        {
+            build();
+        }
+    }
+
+    // Answer for a different graph (schedule reload); rebuilt right away if
+    // this one was in use, otherwise on the first query
+    void setGraph(const Graph *g)
+    {
+        graph = g;
+        if (isBuilt())
+        {
+            build();
+        }
+    }
+    int getShortcutCount() const { return shortcutCount; }
+
+    // Preprocess the graph's current routes
+    void build()
+    {
+        release();
+        builtVersion = graph->getTimetableVersion();
+        portCount = graph->getVertexCount();
+        int slots = portCount > 0 ? portCount : 1;
+
+        // Cheapest lane per ordered pair of ports
+        ArcList *out = new ArcList[slots];
+        ArcList *in = new ArcList[slots];
+        for (int u = 0; u < portCount; u++)
+        {
+            for (int e = graph->getEdgeBegin(u); e < graph->getEdgeEnd(u); e++)
+            {
+                const Graph::Edge &edge = graph->getEdge(e);
+                if (edge.destination == -1 || edge.destination == u)
+                    continue;
+                out[u].relax(edge.destination, edge.cost, -1);
+                in[edge.destination].relax(u, edge.cost, -1);
+            }
+        }
+
+        bool *contracted = new bool[slots];
+        int *deletedNeighbors = new int[slots];
+        int *dist = new int[slots];
+        int *reached = new int[slots];
+        rank = new int[slots];
+        for (int v = 0; v < portCount; v++)
+        {
+            contracted[v] = false;
+            deletedNeighbors[v] = 0;
+            dist[v] = UNREACHABLE;
+        }
+
+        // Importance: shortcuts added minus arcs removed, plus how many
+        // neighbours are already gone (spreads contraction evenly). Scores
+        // only grow as neighbours are contracted, so they are refreshed
+        // lazily when a port reaches the front of the queue.
+        IndexedMinHeap<int> witnessFrontier(portCount);
+        IndexedMinHeap<int> order(portCount);
+        for (int v = 0; v < portCount; v++)
+        {
+            int shortcuts = contract(v, false, out, in, contracted, dist, reached, witnessFrontier);
+            order.pushOrDecrease(v, shortcuts - out[v].size - in[v].size);
+        }
+
+        int nextRank = 0;
+        int v, priority;
+        while (order.extractMin(v, priority))
+        {
+            int arcs = 0;
+            for (int i = 0; i < out[v].size; i++)
+                arcs += contracted[out[v].items[i].target] ? 0 : 1;
+            for (int i = 0; i < in[v].size; i++)
+                arcs += contracted[in[v].items[i].target] ? 0 : 1;
+            int current = contract(v, false, out, in, contracted, dist, reached, witnessFrontier) - arcs + deletedNeighbors[v];
+            if (current > priority)
+            {
+                order.pushOrDecrease(v, current);
+                continue;
+            }
+
+            shortcutCount += contract(v, true, out, in, contracted, dist, reached, witnessFrontier);
+            contracted[v] = true;
+            rank[v] = nextRank++;
+            for (int i = 0; i < out[v].size; i++)
+                deletedNeighbors[out[v].items[i].target]++;
+            for (int i = 0; i < in[v].size; i++)
+                deletedNeighbors[in[v].items[i].target]++;
+        }
+
+        // Split every arc (real or shortcut) into the upward search graphs
+        upOffsets = new int[portCount + 1];
+        downOffsets = new int[portCount + 1];
+        for (int u = 0; u <= portCount; u++)
+        {
+            upOffsets[u] = 0;
+            downOffsets[u] = 0;
+        }
+        int totalArcs = 0;
+        for (int u = 0; u < portCount; u++)
+        {
+            for (int i = 0; i < out[u].size; i++)
+            {
+                int w = out[u].items[i].target;
+                if (rank[w] > rank[u])
+                    upOffsets[u + 1]++;
+                else
+                    downOffsets[w + 1]++;
+                totalArcs++;
+            }
+        }
+        for (int u = 0; u < portCount; u++)
+        {
+            upOffsets[u + 1] += upOffsets[u];
+            downOffsets[u + 1] += downOffsets[u];
+        }
+        upArcs = new Arc[totalArcs > 0 ? totalArcs : 1];
+        downArcs = new Arc[totalArcs > 0 ? totalArcs : 1];
+        int *nextUp = new int[slots];
+        int *nextDown = new int[slots];
+        for (int u = 0; u < portCount; u++)
+        {
+            nextUp[u] = upOffsets[u];
+            nextDown[u] = downOffsets[u];
+        }
+        for (int u = 0; u < portCount; u++)
+        {
+            for (int i = 0; i < out[u].size; i++)
+            {
+                Arc arc = out[u].items[i];
+                if (rank[arc.target] > rank[u])
+                {
+                    upArcs[nextUp[u]++] = arc;
+                }
+                else
+                {
+                    int w = arc.target;
+                    arc.target = u;
+                    downArcs[nextDown[w]++] = arc;
+                }
+            }
+        }
+
+        forwardDist = new int[slots];
+        backwardDist = new int[slots];
+        forwardParent = new int[slots];
+        backwardParent = new int[slots];
+        touched = new int[slots];
+        touchedCount = 0;
+        forward = IndexedMinHeap<int>(slots);
+        backward = IndexedMinHeap<int>(slots);
+        for (int p = 0; p < portCount; p++)
+        {
+            forwardDist[p] = UNREACHABLE;
+            backwardDist[p] = UNREACHABLE;
+        }
+
+        delete[] nextUp;
+        delete[] nextDown;
+        delete[] out;
+        delete[] in;
+        delete[] contracted;
+        delete[] deletedNeighbors;
+        delete[] dist;
+        delete[] reached;
+    }
+
+    // Cheapest lane cost between two port IDs (UNREACHABLE if none)
+    int getLaneCost(int from, int to)
+    {
+        refresh();
+        if (from < 0 || to < 0 || from >= portCount || to >= portCount)
+            return UNREACHABLE;
+        int meeting;
+        return search(from, to, meeting);
+    }
+
+    int getLaneCost(const string &origin, const string &destination)
+    {
+        return getLaneCost(graph->getPortId(origin), graph->getPortId(destination));
+    }
+
+    // Ports along the cheapest lane, origin first (empty if none)
+    ArrayList<string> getLanePath(const string &origin, const string &destination)
+    {
+        ArrayList<string> path;
+        refresh();
+        int from = graph->getPortId(origin);
+        int to = graph->getPortId(destination);
+        if (from == -1 || to == -1)
+            return path;
+
+        int meeting;
+        if (search(from, to, meeting) == UNREACHABLE)
+            return path;
+
+        // Up from the origin to the meeting port, then down to the destination
+        ArrayList<int> climb;
+        for (int p = meeting; p != -1; p = forwardParent[p])
+        {
+            climb.push_back(p);
+        }
+        climb.reverse();
+        ArrayList<int> ports;
+        ports.push_back(from);
+        for (int i = 0; i + 1 < climb.getSize(); i++)
+        {
+            unpack(climb.get(i), climb.get(i + 1), ports);
+        }
+        for (int p = meeting; backwardParent[p] != -1; p = backwardParent[p])
+        {
+            unpack(p, backwardParent[p], ports);
+        }
+
+        for (int i = 0; i < ports.getSize(); i++)
+        {
+            path.push_back(graph->getPortName(ports.get(i)));
+        }
+        return path;
+    }
+};
+
+#endif
@@ -5,40 +5,117 @@
 
 #include "Port.h"
 #include "Route.h"
-#include "LinkedList.h"
+#include "ArrayList.h"
 #include "Queue.h"
+#include "HashTable.h"
+#include "ReachabilityIndex.h"
+#include "LandmarkIndex.h"
 #include <string>
+#include <cstring>
 using namespace std;
 class Graph
 {
-private:
-    struct EdgeNode
+public:
+    // Packed edge of the CSR adjacency: one per sailing, grouped by origin port
+    struct Edge
+    {
+        int destination; // Destination port ID (-1 if the port is unknown)
+        int cost;
+        int departure;   // Route::departureStamp
+        int arrival;     // Route::arrivalStamp
+        int routeIndex;  // Index of the full Route record (see getRouteByIndex)
+        int company;     // Shipping company ID (see getCompanyId)
+    };
+
+    // Read-only view over a slice of the packed edges (no copying)
+    struct EdgeRange
     {
-        Route route;
-        EdgeNode *next;
+        const Edge *first;
+        const Edge *last;
+
+        EdgeRange(const Edge *f, const Edge *l) : first(f), last(l) {}
+        const Edge *begin() const { return first; }
+        const Edge *end() const { return last; }
+        int getSize() const { return static_cast<int>(last - first); }
+        bool isEmpty() const { return first == last; }
+    };
+
+    // Read-only view of the full Route records behind a slice of edges, in
+    // edge order. Nothing is copied; like EdgeRange it is only valid until
+    // the graph changes (adding routes or ports rebuilds the adjacency).
+    class RouteView
+    {
+    private:
+        const Route *store;
+        const Edge *first;
+        const Edge *last;
+
+    public:
+        class Iterator
+        {
+        private:
+            const Route *store;
+            const Edge *edge;
 
-        EdgeNode(const Route &r) : route(r), next(nullptr) {}
+        public:
+            Iterator(const Route *s, const Edge *e) : store(s), edge(e) {}
+            const Route &operator*() const { return store[edge->routeIndex]; }
+            const Route *operator->() const { return &store[edge->routeIndex]; }
+            Iterator &operator++()
+            {
+                edge++;
+                return *this;
+            }
+            bool operator!=(const Iterator &other) const { return edge != other.edge; }
+            // The packed edge of the current route
+            const Edge &getEdge() const { return *edge; }
+        };
+
+        RouteView() : store(nullptr), first(nullptr), last(nullptr) {}
+        RouteView(const Route *s, const Edge *f, const Edge *l) : store(s), first(f), last(l) {}
+
+        Iterator begin() const { return Iterator(store, first); }
+        Iterator end() const { return Iterator(store, last); }
+        const Route &get(int index) const
+        {
+            // SAFETY CHECK: Prevents crash
+            if (index < 0 || index >= getSize())
+            {
+                static Route dummy;
+                return dummy;
+            }
+            return store[first[index].routeIndex];
+        }
+        int getSize() const { return static_cast<int>(last - first); }
+        bool isEmpty() const { return first == last; }
+        EdgeRange getEdges() const { return EdgeRange(first, last); }
+
+        // Owned copy, for callers that keep the routes past a graph change
+        ArrayList<Route> toList() const
+        {
+            ArrayList<Route> routes;
+            routes.reserve(getSize());
+            for (const Edge *e = first; e != last; e++)
+            {
+                routes.push_back(store[e->routeIndex]);
+            }
+            return routes;
+        }
     };
 
+private:
     struct VertexNode
     {
         Port port;
-        EdgeNode *edges;
         Queue<string> *dockingQueue;
 
-        VertexNode() : port(), edges(nullptr), dockingQueue(nullptr) {}
-        VertexNode(const Port &p) : port(p), edges(nullptr)
+        VertexNode() : port(), dockingQueue(nullptr) {}
+        VertexNode(const Port &p) : port(p)
         {
             dockingQueue = new Queue<string>();
         }
         ~VertexNode()
         {
-            while (edges)
-            {
-                EdgeNode *temp = edges;
-                edges = edges->next;
-                delete temp;
-            }
             if (dockingQueue)
             {
                 delete dockingQueue;
@@ -46,15 +123,283 @@ private:
         }
     };
 
-    LinkedList<VertexNode *> vertices;
+    // Vertices are stored densely by port ID (the order ports were added),
+    // so ID -> vertex is a plain array access
+    VertexNode **vertices;
+    int vertexCapacity;
     int vertexCount;
 
-    // Helper: Find port index by name (linear search - NO HASHTABLE!)
+    // Interned port names: name -> dense port ID
+    HashTable<int> portIds;
+
+    // Every route in insertion order, with its origin port ID alongside
+    Route *routeStore;
+    int *routeOrigins;
+    int routeCapacity;
+    int routeCount;
+
+    // Frozen CSR adjacency: the edges of port p are
+    // edges[edgeOffsets[p] .. edgeOffsets[p + 1]), sorted by departure stamp.
+    // Rebuilt on demand after routes or ports are added, patched in place
+    // by the schedule changes (addSailing etc.).
+    mutable int *edgeOffsets;
+    mutable Edge *edges;
+    // Every route index ordered by departure stamp (the timetable order)
+    mutable int *departureOrder;
+    // Reverse CSR: indices into edges of the sailings arriving at port p are
+    // inEdges[inEdgeOffsets[p] .. inEdgeOffsets[p + 1])
+    mutable int *inEdgeOffsets;
+    mutable int *inEdges;
+    // Interned shipping company names: name -> dense company ID
+    mutable HashTable<int> companyIds;
+    mutable string *companyNames;
+    mutable int companyCount;
+    // Reachability sets and lower-bound tables over the adjacency, built on
+    // first use
+    mutable ReachabilityIndex reachability;
+    mutable bool reachabilityDirty;
+    // ALT landmark tables, built on first use or loaded from disk
+    mutable LandmarkIndex landmarks;
+    mutable bool landmarksDirty;
+    mutable bool adjacencyDirty;
+    // Entries allocated in edges, departureOrder and inEdges
+    mutable int adjacencyCapacity;
+    // Bumped by every change to the sailings (see getTimetableVersion)
+    int timetableVersion;
+
+    // Helper: Find port index by name (hash lookup into the interned IDs)
     int findPortIndex(const string &portName) const
     {
-        for (int i = 0; i < vertices.getSize(); i++)
+        int id = -1;
+        if (portIds.find(portName, id))
+        {
+            return id;
+        }
+        return -1;
+    }
+
+    void growVertices()
+    {
+        vertexCapacity = (vertexCapacity == 0) ? 16 : vertexCapacity * 2;
+        VertexNode **newVertices = new VertexNode *[vertexCapacity];
+        for (int i = 0; i < vertexCount; i++)
+        {
+            newVertices[i] = vertices[i];
+        }
+        delete[] vertices;
+        vertices = newVertices;
+    }
+
+    void growRoutes(int newCapacity)
+    {
+        routeCapacity = newCapacity;
+        Route *newStore = new Route[routeCapacity];
+        int *newOrigins = new int[routeCapacity];
+        for (int i = 0; i < routeCount; i++)
+        {
+            newStore[i] = std::move(routeStore[i]);
+            newOrigins[i] = routeOrigins[i];
+        }
+        delete[] routeStore;
+        delete[] routeOrigins;
+        routeStore = newStore;
+        routeOrigins = newOrigins;
+    }
+
+    // Stable bottom-up merge sort of route indices by departure stamp
+    void sortByDeparture(int *order, int count) const
+    {
+        int *buffer = new int[count > 0 ? count : 1];
+        for (int width = 1; width < count; width *= 2)
+        {
+            for (int lo = 0; lo < count; lo += 2 * width)
+            {
+                int mid = (lo + width < count) ? lo + width : count;
+                int hi = (lo + 2 * width < count) ? lo + 2 * width : count;
+                int a = lo, b = mid, k = lo;
+                while (a < mid && b < hi)
+                {
+                    if (routeStore[order[b]].departureStamp < routeStore[order[a]].departureStamp)
+                        buffer[k++] = order[b++];
+                    else
+                        buffer[k++] = order[a++];
+                }
+                while (a < mid)
+                    buffer[k++] = order[a++];
+                while (b < hi)
+                    buffer[k++] = order[b++];
+            }
+            for (int i = 0; i < count; i++)
+            {
+                order[i] = buffer[i];
+            }
+        }
+        delete[] buffer;
+    }
+
+    // Counting sort of the routes by origin port into the CSR arrays.
+    // Routes are visited in departure order, so each port's slice ends up
+    // sorted by departure stamp.
+    void ensureAdjacency() const
+    {
+        if (!adjacencyDirty)
+        {
+            return;
+        }
+
+        delete[] edgeOffsets;
+        delete[] edges;
+        delete[] departureOrder;
+        delete[] inEdgeOffsets;
+        delete[] inEdges;
+        delete[] companyNames;
+        edgeOffsets = new int[vertexCount + 1];
+        edges = new Edge[routeCount > 0 ? routeCount : 1];
+
+        for (int i = 0; i <= vertexCount; i++)
+        {
+            edgeOffsets[i] = 0;
+        }
+        for (int i = 0; i < routeCount; i++)
+        {
+            edgeOffsets[routeOrigins[i] + 1]++;
+        }
+        for (int i = 0; i < vertexCount; i++)
         {
-            if (vertices.get(i)->port.name == portName)
+            edgeOffsets[i + 1] += edgeOffsets[i];
+        }
+
+        departureOrder = new int[routeCount > 0 ? routeCount : 1];
+        int *order = departureOrder;
+        for (int i = 0; i < routeCount; i++)
+        {
+            order[i] = i;
+        }
+        sortByDeparture(order, routeCount);
+
+        int *next = new int[vertexCount > 0 ? vertexCount : 1];
+        for (int i = 0; i < vertexCount; i++)
+        {
+            next[i] = edgeOffsets[i];
+        }
+        companyIds = HashTable<int>();
+        companyNames = new string[routeCount > 0 ? routeCount : 1];
+        companyCount = 0;
+        for (int k = 0; k < routeCount; k++)
+        {
+            int i = order[k];
+            Edge &edge = edges[next[routeOrigins[i]]++];
+            edge.destination = findPortIndex(routeStore[i].destination);
+            edge.cost = routeStore[i].cost;
+            edge.departure = routeStore[i].departureStamp;
+            edge.arrival = routeStore[i].arrivalStamp;
+            edge.routeIndex = i;
+            if (!companyIds.find(routeStore[i].shippingCompany, edge.company))
+            {
+                edge.company = companyCount;
+                companyNames[companyCount++] = routeStore[i].shippingCompany;
+                companyIds.insert(routeStore[i].shippingCompany, edge.company);
+            }
+        }
+
+        delete[] next;
+
+        buildReverseAdjacency();
+        adjacencyDirty = false;
+    }
+
+    // Reverse CSR from the forward edges (the reachability and landmark
+    // tables are rebuilt when next asked for)
+    void buildReverseAdjacency() const
+    {
+        // Same counting sort again, by destination, for the reverse CSR
+        inEdgeOffsets = new int[vertexCount + 1];
+        inEdges = new int[routeCount > 0 ? routeCount : 1];
+        for (int i = 0; i <= vertexCount; i++)
+        {
+            inEdgeOffsets[i] = 0;
+        }
+        for (int e = 0; e < routeCount; e++)
+        {
+            if (edges[e].destination != -1)
+                inEdgeOffsets[edges[e].destination + 1]++;
+        }
+        for (int i = 0; i < vertexCount; i++)
+        {
+            inEdgeOffsets[i + 1] += inEdgeOffsets[i];
+        }
+        int *next = new int[vertexCount > 0 ? vertexCount : 1];
+        for (int i = 0; i < vertexCount; i++)
+        {
+            next[i] = inEdgeOffsets[i];
+        }
+        for (int e = 0; e < routeCount; e++)
+        {
+            if (edges[e].destination != -1)
+                inEdges[next[edges[e].destination]++] = e;
+        }
+        delete[] next;
+
+        // edges and departureOrder were allocated at this same size
+        adjacencyCapacity = routeCount > 0 ? routeCount : 1;
+
+        reachabilityDirty = true;
+        landmarksDirty = true;
+    }
+
+    // Room for count entries in edges, departureOrder and inEdges
+    void reserveAdjacency(int count)
+    {
+        if (count <= adjacencyCapacity)
+        {
+            return;
+        }
+        int newCapacity = adjacencyCapacity * 2 > count ? adjacencyCapacity * 2 : count;
+        Edge *newEdges = new Edge[newCapacity];
+        int *newOrder = new int[newCapacity];
+        int *newInEdges = new int[newCapacity];
+        memcpy(newEdges, edges, sizeof(Edge) * routeCount);
+        memcpy(newOrder, departureOrder, sizeof(int) * routeCount);
+        memcpy(newInEdges, inEdges, sizeof(int) * inEdgeOffsets[vertexCount]);
+        delete[] edges;
+        delete[] departureOrder;
+        delete[] inEdges;
+        edges = newEdges;
+        departureOrder = newOrder;
+        inEdges = newInEdges;
+        adjacencyCapacity = newCapacity;
+    }
+
+    // Same sailing: destination, departure and company (origin is checked
+    // by the caller)
+    static bool sameSailing(const Route &a, const Route &b)
+    {
+        return a.destination == b.destination && a.departureStamp == b.departureStamp &&
+               a.shippingCompany == b.shippingCompany;
+    }
+
+    // Edge of a sailing out of originIndex, or -1
+    int findSailingEdge(int originIndex, const Route &sailing) const
+    {
+        int end = edgeOffsets[originIndex + 1];
+        for (int e = lowerBoundDeparture(originIndex, sailing.departureStamp);
+             e < end && edges[e].departure == sailing.departureStamp; e++)
+        {
+            if (sameSailing(routeStore[edges[e].routeIndex], sailing))
+            {
+                return e;
+            }
+        }
+        return -1;
+    }
+
+    // Route index of a sailing out of originIndex by a scan of the route
+    // store (while the adjacency is not built), or -1
+    int findSailingRoute(int originIndex, const Route &sailing) const
+    {
+        for (int i = 0; i < routeCount; i++)
+        {
+            if (routeOrigins[i] == originIndex && sameSailing(routeStore[i], sailing))
             {
                 return i;
             }
@@ -62,15 +407,73 @@ private:
         return -1;
     }
 
+    // First position in departureOrder whose route departs after stamp
+    int departureRankAfter(int stamp) const
+    {
+        int lo = 0;
+        int hi = routeCount;
+        while (lo < hi)
+        {
+            int mid = lo + (hi - lo) / 2;
+            if (routeStore[departureOrder[mid]].departureStamp <= stamp)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    // Take route r out of the store, keeping the others in insertion order
+    void eraseRoute(int r)
+    {
+        for (int i = r; i < routeCount - 1; i++)
+        {
+            routeStore[i] = std::move(routeStore[i + 1]);
+            routeOrigins[i] = routeOrigins[i + 1];
+        }
+        routeCount--;
+        routeStore[routeCount] = Route();
+    }
+
+    // First edge of a port's slice departing at or after the given stamp
+    int lowerBoundDeparture(int portId, int stamp) const
+    {
+        int lo = edgeOffsets[portId];
+        int hi = edgeOffsets[portId + 1];
+        while (lo < hi)
+        {
+            int mid = lo + (hi - lo) / 2;
+            if (edges[mid].departure < stamp)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
 public:
-    Graph() : vertexCount(0) {}
+    Graph() : vertices(nullptr), vertexCapacity(0), vertexCount(0),
+              routeStore(nullptr), routeOrigins(nullptr), routeCapacity(0), routeCount(0),
+              edgeOffsets(nullptr), edges(nullptr), departureOrder(nullptr),
+              inEdgeOffsets(nullptr), inEdges(nullptr), companyNames(nullptr), companyCount(0),
+              reachabilityDirty(true), landmarksDirty(true), adjacencyDirty(true), adjacencyCapacity(0),
+              timetableVersion(0) {}
 
     ~Graph()
     {
-        for (int i = 0; i < vertices.getSize(); i++)
+        for (int i = 0; i < vertexCount; i++)
         {
-            delete vertices.get(i);
+            delete vertices[i];
         }
+        delete[] vertices;
+        delete[] routeStore;
+        delete[] routeOrigins;
+        delete[] edgeOffsets;
+        delete[] edges;
+        delete[] departureOrder;
+        delete[] inEdgeOffsets;
+        delete[] inEdges;
+        delete[] companyNames;
     }
 
     void addPort(const Port &port)
@@ -80,9 +483,16 @@ public:
             return;
         }
 
-        VertexNode *newVertex = new VertexNode(port);
-        vertices.push_back(newVertex);
+        if (vertexCount >= vertexCapacity)
+        {
+            growVertices();
+        }
+
+        vertices[vertexCount] = new VertexNode(port);
+        portIds.insert(port.name, vertexCount);
         vertexCount++;
+        adjacencyDirty = true;
+        timetableVersion++;
     }
 
     void addRoute(const Route &route)
@@ -93,127 +503,423 @@ public:
             return;
         }
 
-        VertexNode *originVertex = vertices.get(originIndex);
-        EdgeNode *newEdge = new EdgeNode(route);
+        if (routeCount >= routeCapacity)
+        {
+            growRoutes(routeCapacity == 0 ? 64 : routeCapacity * 2);
+        }
 
-        newEdge->next = originVertex->edges;
-        originVertex->edges = newEdge;
+        routeStore[routeCount] = route;
+        routeOrigins[routeCount] = originIndex;
+        routeCount++;
+        adjacencyDirty = true;
+        timetableVersion++;
     }
 
-    LinkedList<Route> getRoutesFrom(const string &portName) const
+    // Room for count routes in total before the route store grows again
+    void reserveRoutes(int count)
     {
-        LinkedList<Route> routes;
-        int index = findPortIndex(portName);
-
-        if (index != -1)
+        if (count > routeCapacity)
         {
-            VertexNode *vertex = vertices.get(index);
-            EdgeNode *current = vertex->edges;
+            growRoutes(count);
+        }
+    }
 
-            while (current)
-            {
-                routes.push_back(current->route);
-                current = current->next;
-            }
+    // Install a frozen adjacency taken from a graph with these same ports
+    // and routes (see ScheduleSnapshot) instead of sorting the routes again:
+    // getVertexCount() + 1 offsets, getRouteCount() edges and departure
+    // ranks, the company names in company ID order, the reverse CSR
+    // (getVertexCount() + 1 offsets, getRouteCount() edge indices) and the
+    // reachability tables as ReachabilityIndex::write() saved them
+    // (nullptr to build them on first use).
+    void restoreAdjacency(const int *offsets, const Edge *packedEdges, const int *order,
+                          const string *companies, int count,
+                          const int *inOffsets, const int *inEdgeIndices, const char *reachabilityImage)
+    {
+        delete[] edgeOffsets;
+        delete[] edges;
+        delete[] departureOrder;
+        delete[] inEdgeOffsets;
+        delete[] inEdges;
+        delete[] companyNames;
+        edgeOffsets = new int[vertexCount + 1];
+        edges = new Edge[routeCount > 0 ? routeCount : 1];
+        departureOrder = new int[routeCount > 0 ? routeCount : 1];
+        memcpy(edgeOffsets, offsets, sizeof(int) * (vertexCount + 1));
+        memcpy(edges, packedEdges, sizeof(Edge) * routeCount);
+        memcpy(departureOrder, order, sizeof(int) * routeCount);
+
+        companyIds = HashTable<int>(count);
+        companyNames = new string[count > 0 ? count : 1];
+        companyCount = count;
+        for (int c = 0; c < count; c++)
+        {
+            companyNames[c] = companies[c];
+            companyIds.insert(companies[c], c);
         }
 
-        return routes;
+        inEdgeOffsets = new int[vertexCount + 1];
+        inEdges = new int[routeCount > 0 ? routeCount : 1];
+        memcpy(inEdgeOffsets, inOffsets, sizeof(int) * (vertexCount + 1));
+        memcpy(inEdges, inEdgeIndices, sizeof(int) * routeCount);
+        adjacencyCapacity = routeCount > 0 ? routeCount : 1;
+
+        reachabilityDirty = reachabilityImage == nullptr;
+        if (!reachabilityDirty)
+        {
+            reachability.restore(vertexCount, companyCount, reachabilityImage);
+        }
+        landmarksDirty = true;
+        adjacencyDirty = false;
     }
 
-    LinkedList<Route> getRoutesFromOnDate(const string &portName,
-                                          const string &date) const
+    // Freeze the adjacency now (RouteParser calls this once after loading);
+    // otherwise it is built lazily by the first query
+    void buildAdjacency()
     {
-        LinkedList<Route> routes;
-        int index = findPortIndex(portName);
+        ensureAdjacency();
+    }
 
-        if (index != -1)
+    // ---- Schedule changes ----
+    // Deltas applied in place instead of a reload. A sailing is identified
+    // by origin, destination, departure (date and time) and company. With
+    // the adjacency built, it is slotted into or taken out of its port's
+    // departure-sorted slice, the reverse CSR and the timetable order with
+    // linear moves (no sorting), and the reachability and landmark tables
+    // are lowered through new or cheaper sailings instead of being rebuilt;
+    // cancelled or dearer sailings leave them valid, only looser. Route
+    // indices keep insertion order, so the result is what a fresh load of
+    // the same routes gives, except that a new company takes the next
+    // free ID. Both ports must already exist (addPort still means a full
+    // rebuild on the next query). Views, edge pointers and route indices
+    // taken before a change are invalid after it.
+
+    // Changes whenever a sailing or port is added, cancelled or repriced;
+    // holders of derived copies (e.g. ConnectionScanner) compare it to know
+    // when to refresh
+    int getTimetableVersion() const { return timetableVersion; }
+
+    // False if either port is unknown
+    bool addSailing(const Route &sailing)
+    {
+        int origin = findPortIndex(sailing.origin);
+        int destination = findPortIndex(sailing.destination);
+        if (origin == -1 || destination == -1)
         {
-            VertexNode *vertex = vertices.get(index);
-            EdgeNode *current = vertex->edges;
+            return false;
+        }
+        if (adjacencyDirty)
+        {
+            addRoute(sailing);
+            return true;
+        }
 
-            while (current)
+        int company;
+        if (!companyIds.find(sailing.shippingCompany, company))
+        {
+            string *grown = new string[companyCount + 1];
+            for (int c = 0; c < companyCount; c++)
             {
-                if (current->route.date == date)
-                {
-                    routes.push_back(current->route);
-                }
-                current = current->next;
+                grown[c] = std::move(companyNames[c]);
+            }
+            delete[] companyNames;
+            companyNames = grown;
+            company = companyCount++;
+            companyNames[company] = sailing.shippingCompany;
+            companyIds.insert(companyNames[company], company);
+            if (!reachabilityDirty)
+            {
+                reachability.ensureCompanies(companyCount);
             }
         }
 
-        return routes;
-    }
+        if (routeCount >= routeCapacity)
+        {
+            growRoutes(routeCapacity == 0 ? 64 : routeCapacity * 2);
+        }
+        int r = routeCount;
+        routeStore[r] = sailing;
+        routeOrigins[r] = origin;
+        reserveAdjacency(routeCount + 1);
 
-    // Get routes from a port on the next day (for next-day connections)
-    LinkedList<Route> getRoutesFromNextDay(const string &portName,
-                                           const string &currentDate) const
-    {
-        LinkedList<Route> routes;
-        string nextDay = Route::getNextDay(currentDate);
-        return getRoutesFromOnDate(portName, nextDay);
+        // After the port's sailings departing at or before it (the newest
+        // route goes last among equal departures, as in a full build)
+        int e = lowerBoundDeparture(origin, sailing.departureStamp + 1);
+        memmove(edges + e + 1, edges + e, sizeof(Edge) * (routeCount - e));
+        Edge &edge = edges[e];
+        edge.destination = destination;
+        edge.cost = sailing.cost;
+        edge.departure = sailing.departureStamp;
+        edge.arrival = sailing.arrivalStamp;
+        edge.routeIndex = r;
+        edge.company = company;
+        for (int p = origin + 1; p <= vertexCount; p++)
+        {
+            edgeOffsets[p]++;
+        }
+
+        // Reverse CSR: renumber the edges that moved up, then insert the new
+        // one in the destination's slice (which is in edge order)
+        int inCount = inEdgeOffsets[vertexCount];
+        for (int i = 0; i < inCount; i++)
+        {
+            if (inEdges[i] >= e)
+                inEdges[i]++;
+        }
+        int slot = inEdgeOffsets[destination];
+        while (slot < inEdgeOffsets[destination + 1] && inEdges[slot] < e)
+        {
+            slot++;
+        }
+        memmove(inEdges + slot + 1, inEdges + slot, sizeof(int) * (inCount - slot));
+        inEdges[slot] = e;
+        for (int p = destination + 1; p <= vertexCount; p++)
+        {
+            inEdgeOffsets[p]++;
+        }
+
+        int rank = departureRankAfter(sailing.departureStamp);
+        memmove(departureOrder + rank + 1, departureOrder + rank, sizeof(int) * (routeCount - rank));
+        departureOrder[rank] = r;
+        routeCount++;
+
+        if (!reachabilityDirty)
+        {
+            reachability.addSailing(origin, destination, company, sailing.cost,
+                                    sailing.arrivalStamp - sailing.departureStamp);
+        }
+        if (!landmarksDirty)
+        {
+            landmarks.relaxSailing(origin, destination, sailing.cost, edgeOffsets, edges, inEdgeOffsets, inEdges);
+        }
+        timetableVersion++;
+        return true;
     }
 
-    // Get routes from a port that can connect after a given arrival time and date
-    // This includes same-day routes (if departure >= arrival) and any future routes
-    // Supports multi-day waiting if cheaper
-    LinkedList<Route> getConnectingRoutes(const string &portName,
-                                          const string &arrivalDate, const string &arrivalTime) const
+    // False if no such sailing is scheduled
+    bool cancelSailing(const Route &sailing)
     {
-        LinkedList<Route> validRoutes;
+        int origin = findPortIndex(sailing.origin);
+        if (origin == -1)
+        {
+            return false;
+        }
+        if (adjacencyDirty)
+        {
+            int r = findSailingRoute(origin, sailing);
+            if (r == -1)
+            {
+                return false;
+            }
+            eraseRoute(r);
+            timetableVersion++;
+            return true;
+        }
 
-        // Get ALL routes from this port
-        LinkedList<Route> allRoutes = getRoutesFrom(portName);
+        int e = findSailingEdge(origin, sailing);
+        if (e == -1)
+        {
+            return false;
+        }
+        int r = edges[e].routeIndex;
+        int destination = edges[e].destination;
+        int company = edges[e].company;
 
-        for (int i = 0; i < allRoutes.getSize(); i++)
+        memmove(edges + e, edges + e + 1, sizeof(Edge) * (routeCount - e - 1));
+        for (int p = origin + 1; p <= vertexCount; p++)
         {
-            const Route &route = allRoutes.get(i);
+            edgeOffsets[p]--;
+        }
 
-            // Check if route departs on or after arrival date
-            if (Route::compareDates(route.date, arrivalDate) > 0)
+        int inCount = inEdgeOffsets[vertexCount];
+        if (destination != -1)
+        {
+            int slot = inEdgeOffsets[destination];
+            while (inEdges[slot] != e)
             {
-                // Future date - always valid
-                validRoutes.push_back(route);
+                slot++;
             }
-            else if (route.date == arrivalDate)
+            memmove(inEdges + slot, inEdges + slot + 1, sizeof(int) * (inCount - slot - 1));
+            inCount--;
+            for (int p = destination + 1; p <= vertexCount; p++)
             {
-                // Same date - check if departure time >= arrival time
-                if (Route::isTimeBefore(arrivalTime, route.departureTime) || arrivalTime == route.departureTime)
-                {
-                    validRoutes.push_back(route);
-                }
+                inEdgeOffsets[p]--;
             }
-            // If route.date < arrivalDate, skip it (past routes not valid)
+        }
+        for (int i = 0; i < inCount; i++)
+        {
+            if (inEdges[i] > e)
+                inEdges[i]--;
+        }
+
+        int rank = departureRankAfter(sailing.departureStamp) - 1;
+        while (departureOrder[rank] != r)
+        {
+            rank--;
+        }
+        memmove(departureOrder + rank, departureOrder + rank + 1, sizeof(int) * (routeCount - rank - 1));
+
+        eraseRoute(r);
+        for (int i = 0; i < routeCount; i++)
+        {
+            if (edges[i].routeIndex > r)
+                edges[i].routeIndex--;
+            if (departureOrder[i] > r)
+                departureOrder[i]--;
         }
 
-        return validRoutes;
+        // The port stays a predecessor if another sailing of the company remains
+        if (destination != -1 && !reachabilityDirty)
+        {
+            bool remaining = false;
+            for (int i = edgeOffsets[origin]; i < edgeOffsets[origin + 1] && !remaining; i++)
+            {
+                remaining = edges[i].destination == destination && edges[i].company == company;
+            }
+            reachability.setPredecessor(destination, company, origin, remaining);
+        }
+        timetableVersion++;
+        return true;
     }
 
-    LinkedList<Route> getAllRoutes() const
+    // False if no such sailing is scheduled
+    bool repriceSailing(const Route &sailing, int newCost)
     {
-        LinkedList<Route> allRoutes;
-
-        for (int i = 0; i < vertices.getSize(); i++)
+        int origin = findPortIndex(sailing.origin);
+        if (origin == -1)
         {
-            VertexNode *vertex = vertices.get(i);
-            EdgeNode *current = vertex->edges;
+            return false;
+        }
+        if (adjacencyDirty)
+        {
+            int r = findSailingRoute(origin, sailing);
+            if (r == -1)
+            {
+                return false;
+            }
+            routeStore[r].cost = newCost;
+            timetableVersion++;
+            return true;
+        }
 
-            while (current)
+        int e = findSailingEdge(origin, sailing);
+        if (e == -1)
+        {
+            return false;
+        }
+        int oldCost = edges[e].cost;
+        edges[e].cost = newCost;
+        routeStore[edges[e].routeIndex].cost = newCost;
+        if (newCost < oldCost && edges[e].destination != -1)
+        {
+            if (!reachabilityDirty)
+            {
+                reachability.lowerCost(origin, edges[e].destination, newCost);
+            }
+            if (!landmarksDirty)
             {
-                allRoutes.push_back(current->route);
-                current = current->next;
+                landmarks.relaxSailing(origin, edges[e].destination, newCost, edgeOffsets, edges, inEdgeOffsets, inEdges);
             }
         }
+        timetableVersion++;
+        return true;
+    }
+
+    // Port charges feed no derived structure, so this is a plain update;
+    // false if the port is unknown
+    bool setDailyCharge(const string &portName, int charge)
+    {
+        int index = findPortIndex(portName);
+        if (index == -1)
+        {
+            return false;
+        }
+        vertices[index]->port.dailyCharge = charge;
+        return true;
+    }
+
+    RouteView getRoutesFrom(const string &portName) const
+    {
+        int index = findPortIndex(portName);
+        if (index == -1)
+        {
+            return RouteView();
+        }
+
+        ensureAdjacency();
+        return RouteView(routeStore, edges + edgeOffsets[index], edges + edgeOffsets[index + 1]);
+    }
+
+    RouteView getRoutesFromOnDate(const string &portName,
+                                  const string &date) const
+    {
+        int index = findPortIndex(portName);
+        if (index == -1)
+        {
+            return RouteView();
+        }
+
+        ensureAdjacency();
+        int dayStart = Route::dayNumber(date) * Route::MINUTES_PER_DAY;
+        int dayEnd = dayStart + Route::MINUTES_PER_DAY;
+        int first = lowerBoundDeparture(index, dayStart);
+        int last = lowerBoundDeparture(index, dayEnd);
+        return RouteView(routeStore, edges + first, edges + last);
+    }
+
+    // Get routes from a port on the next day (for next-day connections)
+    RouteView getRoutesFromNextDay(const string &portName,
+                                   const string &currentDate) const
+    {
+        string nextDay = Route::getNextDay(currentDate);
+        return getRoutesFromOnDate(portName, nextDay);
+    }
+
+    // Get routes from a port that can connect after a given arrival time and date
+    // This includes same-day routes (if departure >= arrival) and any future routes
+    // Supports multi-day waiting if cheaper
+    RouteView getConnectingRoutes(const string &portName,
+                                  const string &arrivalDate, const string &arrivalTime) const
+    {
+        return getConnectingRoutes(portName, Route::toTimestamp(arrivalDate, arrivalTime));
+    }
+
+    // Same, with the arrival given as a timestamp (see Route::departureStamp)
+    RouteView getConnectingRoutes(const string &portName, int arrivalStamp) const
+    {
+        int index = findPortIndex(portName);
+        if (index == -1)
+        {
+            return RouteView();
+        }
+
+        EdgeRange departures = getDeparturesAfter(index, arrivalStamp);
+        return RouteView(routeStore, departures.begin(), departures.end());
+    }
 
-        return allRoutes;
+    // Zero-copy version for the searches: every edge out of a port that
+    // departs at or after arrivalStamp (binary search in the sorted slice)
+    EdgeRange getDeparturesAfter(int portId, int arrivalStamp) const
+    {
+        ensureAdjacency();
+        return EdgeRange(edges + lowerBoundDeparture(portId, arrivalStamp),
+                         edges + edgeOffsets[portId + 1]);
     }
 
-    LinkedList<Port> getAllPorts() const
+    // Every route, grouped by origin port and in departure order within a port
+    RouteView getAllRoutes() const
     {
-        LinkedList<Port> allPorts;
+        ensureAdjacency();
+        return RouteView(routeStore, edges, edges + routeCount);
+    }
 
-        for (int i = 0; i < vertices.getSize(); i++)
+    ArrayList<Port> getAllPorts() const
+    {
+        ArrayList<Port> allPorts;
+        allPorts.reserve(vertexCount);
+
+        for (int i = 0; i < vertexCount; i++)
         {
-            allPorts.push_back(vertices.get(i)->port);
+            allPorts.push_back(vertices[i]->port);
         }
 
         return allPorts;
@@ -229,7 +935,7 @@ public:
         int index = findPortIndex(portName);
         if (index != -1)
         {
-            port = vertices.get(index)->port;
+            port = vertices[index]->port;
             return true;
         }
         return false;
@@ -240,7 +946,7 @@ public:
         int index = findPortIndex(portName);
         if (index != -1)
         {
-            vertices.get(index)->dockingQueue->enqueue(shipName);
+            vertices[index]->dockingQueue->enqueue(shipName);
         }
     }
 
@@ -249,7 +955,7 @@ public:
         int index = findPortIndex(portName);
         if (index != -1)
         {
-            return vertices.get(index)->dockingQueue->dequeue();
+            return vertices[index]->dockingQueue->dequeue();
         }
         return false;
     }
@@ -259,39 +965,196 @@ public:
         int index = findPortIndex(portName);
         if (index != -1)
         {
-            return vertices.get(index)->dockingQueue->getSize();
+            return vertices[index]->dockingQueue->getSize();
         }
         return 0;
     }
 
+    // Append the ships waiting at other's ports to the same ports here
+    // (ports this graph does not have are skipped); carries the docking
+    // queues over when a reloaded schedule replaces a graph
+    void copyDockingQueuesFrom(const Graph &other)
+    {
+        for (int i = 0; i < other.vertexCount; i++)
+        {
+            int index = findPortIndex(other.vertices[i]->port.name);
+            if (index == -1 || other.vertices[i]->dockingQueue == nullptr)
+            {
+                continue;
+            }
+            for (const string &ship : *other.vertices[i]->dockingQueue)
+            {
+                vertices[index]->dockingQueue->enqueue(ship);
+            }
+        }
+    }
+
     // Get all ships in docking queue for a port
-    LinkedList<string> getQueueShips(const string &portName) const
+    ArrayList<string> getQueueShips(const string &portName) const
     {
-        LinkedList<string> ships;
+        ArrayList<string> ships;
         int index = findPortIndex(portName);
-        if (index != -1 && vertices.get(index)->dockingQueue != nullptr)
+        if (index != -1 && vertices[index]->dockingQueue != nullptr)
         {
-            Queue<string> *queue = vertices.get(index)->dockingQueue;
-            // Create a temporary queue to preserve original
-            Queue<string> tempQueue;
-            while (!queue->isEmpty())
+            const Queue<string> *queue = vertices[index]->dockingQueue;
+            ships.reserve(queue->getSize());
+            for (const string &ship : *queue)
             {
-                string ship = queue->getFront();
                 ships.push_back(ship);
-                tempQueue.enqueue(ship);
-                queue->dequeue();
-            }
-            // Restore original queue
-            while (!tempQueue.isEmpty())
-            {
-                queue->enqueue(tempQueue.getFront());
-                tempQueue.dequeue();
             }
         }
         return ships;
     }
 
     int getVertexCount() const { return vertexCount; }
+    int getRouteCount() const { return routeCount; }
+
+    // CSR edge range of a port: edges [getEdgeBegin(id), getEdgeEnd(id))
+    int getEdgeBegin(int portId) const
+    {
+        ensureAdjacency();
+        return edgeOffsets[portId];
+    }
+
+    int getEdgeEnd(int portId) const
+    {
+        ensureAdjacency();
+        return edgeOffsets[portId + 1];
+    }
+
+    const Edge &getEdge(int edgeIndex) const
+    {
+        ensureAdjacency();
+        return edges[edgeIndex];
+    }
+
+    // Reverse CSR: sailings into a port are
+    // getEdge(getInEdge(i)) for i in [getInEdgeBegin(id), getInEdgeEnd(id))
+    int getInEdgeBegin(int portId) const
+    {
+        ensureAdjacency();
+        return inEdgeOffsets[portId];
+    }
+
+    int getInEdgeEnd(int portId) const
+    {
+        ensureAdjacency();
+        return inEdgeOffsets[portId + 1];
+    }
+
+    int getInEdge(int i) const
+    {
+        ensureAdjacency();
+        return inEdges[i];
+    }
+
+    // Position of an edge (e.g. from an EdgeRange) in the packed edge array
+    int getEdgeIndex(const Edge *edge) const
+    {
+        return static_cast<int>(edge - edges);
+    }
+
+    const Route &getRouteByIndex(int routeIndex) const
+    {
+        return routeStore[routeIndex];
+    }
+
+    // Origin port ID of a route
+    int getRouteOriginId(int routeIndex) const
+    {
+        return routeOrigins[routeIndex];
+    }
+
+    // Route index of the rank-th sailing across the whole timetable in
+    // departure order (stable, so ties keep insertion order)
+    int getRouteByDepartureRank(int rank) const
+    {
+        ensureAdjacency();
+        return departureOrder[rank];
+    }
+
+    // Dense port ID for a name (-1 if unknown); IDs run 0..getVertexCount()-1
+    int getPortId(const string &portName) const
+    {
+        return findPortIndex(portName);
+    }
+
+    // ID -> port lookups (id must be a valid port ID)
+    const Port &getPortById(int id) const
+    {
+        return vertices[id]->port;
+    }
+
+    const string &getPortName(int id) const
+    {
+        return vertices[id]->port.name;
+    }
+
+    // Dense shipping company ID for a name (-1 if no route uses it)
+    int getCompanyId(const string &company) const
+    {
+        ensureAdjacency();
+        int id = -1;
+        if (companyIds.find(company, id))
+        {
+            return id;
+        }
+        return -1;
+    }
+
+    int getCompanyCount() const
+    {
+        ensureAdjacency();
+        return companyCount;
+    }
+
+    const string &getCompanyName(int id) const
+    {
+        ensureAdjacency();
+        return companyNames[id];
+    }
+
+    // Precomputed reachability and admissible lower bounds (see ReachabilityIndex)
+    const ReachabilityIndex &getReachability() const
+    {
+        ensureAdjacency();
+        if (reachabilityDirty)
+        {
+            reachability.build(vertexCount, companyCount, edgeOffsets, edges);
+            reachabilityDirty = false;
+        }
+        return reachability;
+    }
+
+    // ALT landmark bounds (see LandmarkIndex), built here if not loaded
+    const LandmarkIndex &getLandmarks() const
+    {
+        ensureAdjacency();
+        if (landmarksDirty)
+        {
+            landmarks.build(vertexCount, edgeOffsets, edges, inEdgeOffsets, inEdges);
+            landmarksDirty = false;
+        }
+        return landmarks;
+    }
+
+    // Reuse landmark tables saved for this exact network; false if the file
+    // is missing or stale (the tables are then built on first use)
+    bool loadLandmarks(const string &filename)
+    {
+        ensureAdjacency();
+        if (!landmarks.loadFromFile(filename, vertexCount, edgeOffsets, edges))
+        {
+            return false;
+        }
+        landmarksDirty = false;
+        return true;
+    }
+
+    bool saveLandmarks(const string &filename) const
+    {
+        return getLandmarks().saveToFile(filename);
+    }
 };
 
 #endif
\ No newline at end of file
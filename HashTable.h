@@ -3,7 +3,19 @@
 #define HASHTABLE_H
 
 #include <string>
-
+#include <cstring>
+#include <utility>
+
+// String-keyed open-addressing table with robin-hood probing.
+//
+// Every entry remembers its full hash and how far it sits from its home
+// slot. An insert that meets an entry closer to home than itself takes
+// that slot and carries the displaced entry on, which keeps every probe
+// sequence short and sorted by distance, so a lookup can stop as soon as
+// it meets an entry closer to home than the key would be. Removal shifts
+// the following entries back one slot instead of leaving tombstones, and
+// growing moves entries by their stored hash without rehashing any key.
+// Capacity is a power of two and the table grows at 7/8 full.
 template <typename V>
 class HashTable
 {
@@ -12,59 +24,123 @@ private:
     {
         string key;
         V value;
-        bool occupied;
-        bool deleted;
+        unsigned int hash;
+        int distance; // Slots from the home slot, -1 if empty
 
-        Entry() : key(""), value(), occupied(false), deleted(false) {}
+        Entry() : key(""), value(), hash(0), distance(-1) {}
     };
 
     Entry *table;
     int capacity;
     int size;
 
-    int hashFunction(const string &key) const
+public:
+    // FNV-1a with a final avalanche, so the low bits used as the slot
+    // index depend on every character (SymbolTable hashes names with it too)
+    static unsigned int hashOf(const char *key, int length)
     {
-        if (capacity == 0)
-            return 0; // Safety check
+        unsigned int hash = 2166136261u;
+        for (int i = 0; i < length; i++)
+        {
+            hash = (hash ^ static_cast<unsigned char>(key[i])) * 16777619u;
+        }
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6bu;
+        hash ^= hash >> 13;
+        hash *= 0xc2b2ae35u;
+        hash ^= hash >> 16;
+        return hash;
+    }
 
-        unsigned int hash = 0;
-        for (size_t i = 0; i < key.length(); i++)
+private:
+    static int roundUpCapacity(int count)
+    {
+        int wanted = 16;
+        // Room for count entries below the 7/8 load limit
+        while (wanted - wanted / 8 < count)
         {
-            hash = hash * 31 + static_cast<unsigned char>(key[i]);
+            wanted *= 2;
         }
-        return hash % capacity;
+        return wanted;
     }
 
-    int probe(int index, int i) const
+    // Slot holding key, or -1
+    int locate(const char *key, int length, unsigned int hash) const
     {
-        return (index + i) % capacity;
+        int mask = capacity - 1;
+        int index = static_cast<int>(hash) & mask;
+        for (int distance = 0;; distance++)
+        {
+            const Entry &entry = table[index];
+            if (entry.distance < distance)
+            {
+                return -1; // Empty, or the key would have displaced this entry
+            }
+            if (entry.hash == hash && static_cast<int>(entry.key.size()) == length &&
+                memcmp(entry.key.data(), key, length) == 0)
+            {
+                return index;
+            }
+            index = (index + 1) & mask;
+        }
     }
 
-    void resize()
+    // Place an entry known not to be in the table
+    void place(Entry &&incoming)
+    {
+        int mask = capacity - 1;
+        int index = static_cast<int>(incoming.hash) & mask;
+        incoming.distance = 0;
+        while (true)
+        {
+            Entry &slot = table[index];
+            if (slot.distance < 0)
+            {
+                slot = std::move(incoming);
+                size++;
+                return;
+            }
+            if (slot.distance < incoming.distance)
+            {
+                std::swap(slot, incoming);
+            }
+            index = (index + 1) & mask;
+            incoming.distance++;
+        }
+    }
+
+    void rehash(int newCapacity)
     {
-        int oldCapacity = capacity;
         Entry *oldTable = table;
+        int oldCapacity = capacity;
 
-        capacity *= 2;
+        capacity = newCapacity;
         table = new Entry[capacity];
         size = 0;
 
         for (int i = 0; i < oldCapacity; i++)
         {
-            if (oldTable[i].occupied && !oldTable[i].deleted)
+            if (oldTable[i].distance >= 0)
             {
-                insert(oldTable[i].key, oldTable[i].value);
+                place(std::move(oldTable[i]));
             }
         }
 
         delete[] oldTable;
     }
 
+    void growForInsert()
+    {
+        if (size + 1 > capacity - capacity / 8)
+        {
+            rehash(capacity * 2);
+        }
+    }
+
 public:
-    HashTable(int initialCapacity = 101) : capacity(initialCapacity), size(0)
+    // initialCapacity: number of entries expected (the table still grows past it)
+    HashTable(int initialCapacity = 101) : capacity(roundUpCapacity(initialCapacity)), size(0)
     {
-        if (capacity < 10)
-            capacity = 10; // Minimum capacity
         table = new Entry[capacity];
     }
 
@@ -73,129 +149,168 @@ public:
         delete[] table;
     }
 
-    // Copy constructor
-    HashTable(const HashTable &other) : capacity(other.capacity), size(0)
+    // Copy constructor (slots are copied as they are, nothing is rehashed)
+    HashTable(const HashTable &other) : capacity(other.capacity), size(other.size)
     {
         table = new Entry[capacity];
-        for (int i = 0; i < other.capacity; i++)
+        for (int i = 0; i < capacity; i++)
         {
-            if (other.table[i].occupied && !other.table[i].deleted)
-            {
-                insert(other.table[i].key, other.table[i].value);
-            }
+            table[i] = other.table[i];
         }
     }
 
+    HashTable(HashTable &&other) : table(other.table), capacity(other.capacity), size(other.size)
+    {
+        other.table = nullptr;
+        other.capacity = 0;
+        other.size = 0;
+    }
+
     // Assignment operator
     HashTable &operator=(const HashTable &other)
     {
         if (this != &other)
         {
-            delete[] table;
-            capacity = other.capacity;
-            size = 0;
-            table = new Entry[capacity];
+            Entry *newTable = new Entry[other.capacity];
             for (int i = 0; i < other.capacity; i++)
             {
-                if (other.table[i].occupied && !other.table[i].deleted)
-                {
-                    insert(other.table[i].key, other.table[i].value);
-                }
+                newTable[i] = other.table[i];
             }
+            delete[] table;
+            table = newTable;
+            capacity = other.capacity;
+            size = other.size;
         }
         return *this;
     }
 
-    void insert(const string &key, const V &value)
+    HashTable &operator=(HashTable &&other)
     {
-        if (capacity == 0 || size >= capacity * 0.7)
+        if (this != &other)
         {
-            resize();
+            delete[] table;
+            table = other.table;
+            capacity = other.capacity;
+            size = other.size;
+            other.table = nullptr;
+            other.capacity = 0;
+            other.size = 0;
         }
+        return *this;
+    }
 
-        int index = hashFunction(key);
-        int i = 0;
-
-        while (i < capacity && table[probe(index, i)].occupied &&
-               !table[probe(index, i)].deleted &&
-               table[probe(index, i)].key != key)
+    // Make room for count entries without growing again
+    void reserve(int count)
+    {
+        int wanted = roundUpCapacity(count);
+        if (wanted > capacity)
         {
-            i++;
+            rehash(wanted);
         }
+    }
 
-        if (i >= capacity)
+    void insert(const string &key, const V &value)
+    {
+        if (capacity == 0)
+        {
+            // Moved-from (table is null) or copied from one (empty array)
+            delete[] table;
+            capacity = 16;
+            table = new Entry[capacity];
+        }
+        unsigned int hash = hashOf(key.data(), static_cast<int>(key.size()));
+        int index = locate(key.data(), static_cast<int>(key.size()), hash);
+        if (index != -1)
         {
-            // Table full, resize
-            resize();
-            insert(key, value);
+            table[index].value = value;
             return;
         }
 
-        int finalIndex = probe(index, i);
-        if (!table[finalIndex].occupied || table[finalIndex].deleted)
+        growForInsert();
+        Entry entry;
+        entry.key = key;
+        entry.value = value;
+        entry.hash = hash;
+        place(std::move(entry));
+    }
+
+    void insert(string &&key, V &&value)
+    {
+        if (capacity == 0)
+        {
+            // Moved-from (table is null) or copied from one (empty array)
+            delete[] table;
+            capacity = 16;
+            table = new Entry[capacity];
+        }
+        unsigned int hash = hashOf(key.data(), static_cast<int>(key.size()));
+        int index = locate(key.data(), static_cast<int>(key.size()), hash);
+        if (index != -1)
         {
-            size++;
+            table[index].value = std::move(value);
+            return;
         }
 
-        table[finalIndex].key = key;
-        table[finalIndex].value = value;
-        table[finalIndex].occupied = true;
-        table[finalIndex].deleted = false;
+        growForInsert();
+        Entry entry;
+        entry.key = std::move(key);
+        entry.value = std::move(value);
+        entry.hash = hash;
+        place(std::move(entry));
     }
 
-    bool find(const string &key, V &value) const
+    // Lookup by characters, e.g. a token inside a line buffer, without
+    // building a string for it
+    bool find(const char *key, int length, V &value) const
     {
-        if (capacity == 0)
+        if (size == 0)
             return false;
 
-        int index = hashFunction(key);
-        int i = 0;
-
-        while (i < capacity && table[probe(index, i)].occupied)
-        {
-            int currentIndex = probe(index, i);
-            if (!table[currentIndex].deleted && table[currentIndex].key == key)
-            {
-                value = table[currentIndex].value;
-                return true;
-            }
-            i++;
-        }
+        int index = locate(key, length, hashOf(key, length));
+        if (index == -1)
+            return false;
+        value = table[index].value;
+        return true;
+    }
 
-        return false;
+    bool find(const string &key, V &value) const
+    {
+        return find(key.data(), static_cast<int>(key.size()), value);
     }
 
     bool contains(const string &key) const
     {
-        V dummy;
-        return find(key, dummy);
+        return size > 0 && locate(key.data(), static_cast<int>(key.size()),
+                                  hashOf(key.data(), static_cast<int>(key.size()))) != -1;
     }
 
     bool remove(const string &key)
     {
-        if (capacity == 0)
+        if (size == 0)
             return false;
 
-        int index = hashFunction(key);
-        int i = 0;
+        int index = locate(key.data(), static_cast<int>(key.size()),
+                           hashOf(key.data(), static_cast<int>(key.size())));
+        if (index == -1)
+            return false;
 
-        while (i < capacity && table[probe(index, i)].occupied)
+        // Shift the rest of the run back a slot (no tombstone left behind)
+        int mask = capacity - 1;
+        int next = (index + 1) & mask;
+        while (table[next].distance > 0)
         {
-            int currentIndex = probe(index, i);
-            if (!table[currentIndex].deleted && table[currentIndex].key == key)
-            {
-                table[currentIndex].deleted = true;
-                size--;
-                return true;
-            }
-            i++;
+            table[index] = std::move(table[next]);
+            table[index].distance--;
+            index = next;
+            next = (next + 1) & mask;
         }
-
-        return false;
+        table[index] = Entry();
+        size--;
+        return true;
     }
 
     int getSize() const { return size; }
     bool isEmpty() const { return size == 0; }
 };
 
-#endif
\ No newline at end of file
+#endif
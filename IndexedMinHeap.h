@@ -0,0 +1,211 @@
+#pragma once
+#ifndef INDEXEDMINHEAP_H
+#define INDEXEDMINHEAP_H
+#include <utility>
+// d-ary min-heap keyed by dense integer IDs (e.g. port IDs) with decrease-key.
+// Each key is in the heap at most once: a position map tracks where it sits,
+// so improving a key's priority moves it up instead of pushing a duplicate.
+// Sifting moves a "hole" through the array, so payloads are moved rather
+// than copied and each level costs one move instead of a three-way swap.
+template <typename T, typename P = int, int Arity = 4>
+class IndexedMinHeap
+{
+    static_assert(Arity >= 2, "IndexedMinHeap needs an arity of at least 2");
+
+private:
+    struct HeapNode
+    {
+        int key;
+        P priority;
+        T data;
+        HeapNode() : key(-1), priority(), data() {}
+    };
+    HeapNode *heap;
+    int *position; // key -> heap index, -1 if not in the heap
+    int keyCapacity;
+    int size;
+
+    // Fill the hole at index with node, moving parents down until it fits
+    void siftUp(int index, HeapNode &&node)
+    {
+        while (index > 0)
+        {
+            int parent = (index - 1) / Arity;
+            if (!(node.priority < heap[parent].priority))
+            {
+                break;
+            }
+            heap[index] = std::move(heap[parent]);
+            position[heap[index].key] = index;
+            index = parent;
+        }
+        heap[index] = std::move(node);
+        position[heap[index].key] = index;
+    }
+
+    // Fill the hole at index with node, moving the smallest children up
+    void siftDown(int index, HeapNode &&node)
+    {
+        while (true)
+        {
+            int firstChild = index * Arity + 1;
+            if (firstChild >= size)
+            {
+                break;
+            }
+            int lastChild = firstChild + Arity;
+            if (lastChild > size)
+            {
+                lastChild = size;
+            }
+            int smallest = firstChild;
+            for (int child = firstChild + 1; child < lastChild; child++)
+            {
+                if (heap[child].priority < heap[smallest].priority)
+                {
+                    smallest = child;
+                }
+            }
+            if (!(heap[smallest].priority < node.priority))
+            {
+                break;
+            }
+            heap[index] = std::move(heap[smallest]);
+            position[heap[index].key] = index;
+            index = smallest;
+        }
+        heap[index] = std::move(node);
+        position[heap[index].key] = index;
+    }
+
+public:
+    // Keys must lie in [0, capacity); the heap never holds more than capacity items
+    IndexedMinHeap(int capacity) : keyCapacity(capacity > 0 ? capacity : 1), size(0)
+    {
+        heap = new HeapNode[keyCapacity];
+        position = new int[keyCapacity];
+        for (int i = 0; i < keyCapacity; i++)
+        {
+            position[i] = -1;
+        }
+    }
+    ~IndexedMinHeap()
+    {
+        delete[] heap;
+        delete[] position;
+    }
+    IndexedMinHeap(const IndexedMinHeap &) = delete;
+    IndexedMinHeap &operator=(const IndexedMinHeap &) = delete;
+    IndexedMinHeap(IndexedMinHeap &&other)
+        : heap(other.heap), position(other.position),
+          keyCapacity(other.keyCapacity), size(other.size)
+    {
+        other.heap = nullptr;
+        other.position = nullptr;
+        other.keyCapacity = 0;
+        other.size = 0;
+    }
+    IndexedMinHeap &operator=(IndexedMinHeap &&other)
+    {
+        if (this != &other)
+        {
+            delete[] heap;
+            delete[] position;
+            heap = other.heap;
+            position = other.position;
+            keyCapacity = other.keyCapacity;
+            size = other.size;
+            other.heap = nullptr;
+            other.position = nullptr;
+            other.keyCapacity = 0;
+            other.size = 0;
+        }
+        return *this;
+    }
+
+    bool contains(int key) const
+    {
+        return key >= 0 && key < keyCapacity && position[key] != -1;
+    }
+
+    // Insert key, or lower its priority (replacing the payload) if the new
+    // priority is better. Returns false if the key was already queued with
+    // an equal or better priority.
+    bool pushOrDecrease(int key, P priority, T data = T())
+    {
+        if (key < 0 || key >= keyCapacity)
+        {
+            return false;
+        }
+        int index = position[key];
+        if (index == -1)
+        {
+            HeapNode node;
+            node.key = key;
+            node.priority = priority;
+            node.data = std::move(data);
+            size++;
+            siftUp(size - 1, std::move(node));
+            return true;
+        }
+        if (!(priority < heap[index].priority))
+        {
+            return false;
+        }
+        HeapNode node = std::move(heap[index]);
+        node.priority = priority;
+        node.data = std::move(data);
+        siftUp(index, std::move(node));
+        return true;
+    }
+
+    const P &getPriority(int key) const
+    {
+        return heap[position[key]].priority;
+    }
+
+    bool extractMin(int &key, P &priority)
+    {
+        T data;
+        return extractMin(key, priority, data);
+    }
+
+    bool extractMin(int &key, P &priority, T &data)
+    {
+        if (size == 0)
+            return false;
+        key = heap[0].key;
+        priority = heap[0].priority;
+        data = std::move(heap[0].data);
+        position[key] = -1;
+        size--;
+        if (size > 0)
+        {
+            siftDown(0, std::move(heap[size]));
+        }
+        return true;
+    }
+
+    bool isEmpty() const
+    {
+        return size == 0;
+    }
+    int getSize() const
+    {
+        return size;
+    }
+    // Keys must be below this
+    int getCapacity() const
+    {
+        return keyCapacity;
+    }
+    void clear()
+    {
+        for (int i = 0; i < size; i++)
+        {
+            position[heap[i].key] = -1;
+        }
+        size = 0;
+    }
+};
+#endif
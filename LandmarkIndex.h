@@ -0,0 +1,386 @@
+#pragma once
+#ifndef LANDMARK_INDEX_H
+#define LANDMARK_INDEX_H
+
+#include "IndexedMinHeap.h"
+#include <fstream>
+#include <string>
+#include <limits>
+using namespace std;
+// ALT (A*, Landmarks, Triangle inequality) preprocessing.
+//
+// A handful of hub ports are picked as landmarks, and for each one the
+// cheapest plain sailing cost to and from every port is stored. For any
+// ports u, v and landmark L the triangle inequality gives
+//     cost(u, v) >= cost(u, L) - cost(v, L)   and
+//     cost(u, v) >= cost(L, v) - cost(L, u),
+// which is an admissible, consistent lower bound in O(landmarks) memory
+// per port instead of a full table per pair. Waiting and port charges only
+// add to a real voyage, so the bound also holds for timed searches.
+//
+// The tables only depend on the route network, so they are saved next to
+// the routes file and reloaded while the network is unchanged.
+class LandmarkIndex
+{
+public:
+    static const int UNREACHABLE = numeric_limits<int>::max();
+    static const int DEFAULT_LANDMARKS = 8;
+
+private:
+    int portCount;
+    int landmarkCount;
+    unsigned int signature; // Network the tables were built for
+    int *landmarks;
+    int *fromLandmark; // landmark * portCount + port: cost(landmark, port)
+    int *toLandmark;   // landmark * portCount + port: cost(port, landmark)
+
+    void release()
+    {
+        delete[] landmarks;
+        delete[] fromLandmark;
+        delete[] toLandmark;
+        landmarks = nullptr;
+        fromLandmark = nullptr;
+        toLandmark = nullptr;
+        portCount = 0;
+        landmarkCount = 0;
+    }
+
+    void allocate(int ports, int count)
+    {
+        release();
+        portCount = ports;
+        landmarkCount = count;
+        int cells = portCount * landmarkCount;
+        landmarks = new int[landmarkCount > 0 ? landmarkCount : 1];
+        fromLandmark = new int[cells > 0 ? cells : 1];
+        toLandmark = new int[cells > 0 ? cells : 1];
+    }
+
+    // Plain Dijkstra over sailing costs from source, forwards over the CSR
+    // (out-edges) or backwards over the reverse CSR (in-edges)
+    template <typename EdgeT>
+    void dijkstra(int source, bool backward, const int *edgeOffsets, const EdgeT *edges,
+                  const int *inOffsets, const int *inEdges, const int *edgeOrigin,
+                  IndexedMinHeap<int> &frontier, int *distance) const
+    {
+        for (int p = 0; p < portCount; p++)
+        {
+            distance[p] = UNREACHABLE;
+        }
+        distance[source] = 0;
+        frontier.pushOrDecrease(source, 0);
+
+        int port, portDistance;
+        while (frontier.extractMin(port, portDistance))
+        {
+            int first = backward ? inOffsets[port] : edgeOffsets[port];
+            int last = backward ? inOffsets[port + 1] : edgeOffsets[port + 1];
+            for (int i = first; i < last; i++)
+            {
+                int e = backward ? inEdges[i] : i;
+                int next = backward ? edgeOrigin[e] : edges[e].destination;
+                if (next == -1)
+                    continue;
+                if (portDistance + edges[e].cost < distance[next])
+                {
+                    distance[next] = portDistance + edges[e].cost;
+                    frontier.pushOrDecrease(next, distance[next]);
+                }
+            }
+        }
+    }
+
+    // Origin port of edge e (binary search over the CSR offsets)
+    static int originOf(int e, const int *edgeOffsets, int ports)
+    {
+        int lo = 0;
+        int hi = ports - 1;
+        while (lo < hi)
+        {
+            int mid = lo + (hi - lo + 1) / 2;
+            if (edgeOffsets[mid] <= e)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        return lo;
+    }
+
+    // Dijkstra from a port whose distance was just lowered, relaxing only
+    // into ports it improves (the rest of distance stays as it was)
+    template <typename EdgeT>
+    void improve(int source, bool backward, const int *edgeOffsets, const EdgeT *edges,
+                 const int *inOffsets, const int *inEdges,
+                 IndexedMinHeap<int> &frontier, int *distance) const
+    {
+        frontier.clear();
+        frontier.pushOrDecrease(source, distance[source]);
+
+        int port, portDistance;
+        while (frontier.extractMin(port, portDistance))
+        {
+            int first = backward ? inOffsets[port] : edgeOffsets[port];
+            int last = backward ? inOffsets[port + 1] : edgeOffsets[port + 1];
+            for (int i = first; i < last; i++)
+            {
+                int e = backward ? inEdges[i] : i;
+                int next = backward ? originOf(e, edgeOffsets, portCount) : edges[e].destination;
+                if (next == -1)
+                    continue;
+                if (portDistance + edges[e].cost < distance[next])
+                {
+                    distance[next] = portDistance + edges[e].cost;
+                    frontier.pushOrDecrease(next, distance[next]);
+                }
+            }
+        }
+    }
+
+public:
+    LandmarkIndex() : portCount(0), landmarkCount(0), signature(0),
+                      landmarks(nullptr), fromLandmark(nullptr), toLandmark(nullptr) {}
+
+    ~LandmarkIndex()
+    {
+        release();
+    }
+
+    LandmarkIndex(const LandmarkIndex &) = delete;
+    LandmarkIndex &operator=(const LandmarkIndex &) = delete;
+
+    // FNV-1a over the network shape (ports, sailing endpoints and costs)
+    template <typename EdgeT>
+    static unsigned int signatureOf(int ports, const int *edgeOffsets, const EdgeT *edges)
+    {
+        unsigned int hash = 2166136261u;
+        int values[3];
+        values[0] = ports;
+        values[1] = edgeOffsets[ports];
+        for (int v = 0; v < 2; v++)
+        {
+            hash = (hash ^ static_cast<unsigned int>(values[v])) * 16777619u;
+        }
+        for (int p = 0; p < ports; p++)
+        {
+            for (int e = edgeOffsets[p]; e < edgeOffsets[p + 1]; e++)
+            {
+                values[0] = p;
+                values[1] = edges[e].destination;
+                values[2] = edges[e].cost;
+                for (int v = 0; v < 3; v++)
+                {
+                    hash = (hash ^ static_cast<unsigned int>(values[v])) * 16777619u;
+                }
+            }
+        }
+        return hash;
+    }
+
+    // Pick up to count landmarks and fill both tables. The first landmark is
+    // the port with the most sailings; each next one is the port farthest
+    // (round trip) from the landmarks chosen so far, which spreads them to
+    // the edges of the network where the bounds are tightest.
+    template <typename EdgeT>
+    void build(int ports, const int *edgeOffsets, const EdgeT *edges,
+               const int *inOffsets, const int *inEdges, int count = DEFAULT_LANDMARKS)
+    {
+        allocate(ports, count < ports ? count : ports);
+        signature = signatureOf(ports, edgeOffsets, edges);
+        if (landmarkCount == 0)
+        {
+            return;
+        }
+
+        int numEdges = edgeOffsets[portCount];
+        int *edgeOrigin = new int[numEdges > 0 ? numEdges : 1];
+        int *nearest = new int[portCount]; // Round trip to the closest landmark so far
+        int hub = 0;
+        int hubSailings = -1;
+        for (int p = 0; p < portCount; p++)
+        {
+            for (int e = edgeOffsets[p]; e < edgeOffsets[p + 1]; e++)
+            {
+                edgeOrigin[e] = p;
+            }
+            int sailings = (edgeOffsets[p + 1] - edgeOffsets[p]) + (inOffsets[p + 1] - inOffsets[p]);
+            if (sailings > hubSailings)
+            {
+                hubSailings = sailings;
+                hub = p;
+            }
+            nearest[p] = UNREACHABLE;
+        }
+
+        IndexedMinHeap<int> frontier(portCount);
+        int next = hub;
+        for (int l = 0; l < landmarkCount; l++)
+        {
+            if (next == -1)
+            {
+                // Every other port is on a zero-cost round trip through a
+                // landmark, so another one would add nothing; keep those chosen
+                landmarkCount = l;
+                break;
+            }
+            landmarks[l] = next;
+            int *from = fromLandmark + l * portCount;
+            int *to = toLandmark + l * portCount;
+            dijkstra(next, false, edgeOffsets, edges, inOffsets, inEdges, edgeOrigin, frontier, from);
+            dijkstra(next, true, edgeOffsets, edges, inOffsets, inEdges, edgeOrigin, frontier, to);
+
+            int farthest = -1;
+            for (int p = 0; p < portCount; p++)
+            {
+                if (from[p] != UNREACHABLE && to[p] != UNREACHABLE && from[p] + to[p] < nearest[p])
+                {
+                    nearest[p] = from[p] + to[p];
+                }
+                if (nearest[p] == 0)
+                    continue; // Already a landmark
+                if (farthest == -1 || (nearest[p] != UNREACHABLE &&
+                                       (nearest[farthest] == UNREACHABLE || nearest[p] > nearest[farthest])))
+                {
+                    farthest = p;
+                }
+            }
+            next = farthest;
+        }
+
+        delete[] edgeOrigin;
+        delete[] nearest;
+    }
+
+    // A sailing from -> to of this cost was added (or got cheaper): lower
+    // both tables of every landmark through it, spreading each improvement
+    // with a Dijkstra that only visits ports whose cost went down. The edge
+    // arrays must already include the sailing. A cancelled or dearer
+    // sailing needs nothing here; the old tables are still admissible and
+    // consistent for the smaller network, just looser. The signature is
+    // left as built, so tables saved after changes are only reloaded for
+    // the original network, where they are still valid lower bounds.
+    template <typename EdgeT>
+    void relaxSailing(int from, int to, int cost, const int *edgeOffsets, const EdgeT *edges,
+                      const int *inOffsets, const int *inEdges)
+    {
+        if (landmarkCount == 0)
+        {
+            return;
+        }
+        IndexedMinHeap<int> frontier(portCount);
+        for (int l = 0; l < landmarkCount; l++)
+        {
+            int *fromL = fromLandmark + l * portCount;
+            int *toL = toLandmark + l * portCount;
+            if (fromL[from] != UNREACHABLE && fromL[from] + cost < fromL[to])
+            {
+                fromL[to] = fromL[from] + cost;
+                improve(to, false, edgeOffsets, edges, inOffsets, inEdges, frontier, fromL);
+            }
+            if (toL[to] != UNREACHABLE && toL[to] + cost < toL[from])
+            {
+                toL[from] = toL[to] + cost;
+                improve(from, true, edgeOffsets, edges, inOffsets, inEdges, frontier, toL);
+            }
+        }
+    }
+
+    int getLandmarkCount() const { return landmarkCount; }
+    int getLandmark(int l) const { return landmarks[l]; }
+
+    // True if the tables were built for this network
+    template <typename EdgeT>
+    bool matches(int ports, const int *edgeOffsets, const EdgeT *edges) const
+    {
+        return landmarks != nullptr && portCount == ports &&
+               signature == signatureOf(ports, edgeOffsets, edges);
+    }
+
+    // Lower bound on the cost of any voyage from -> to; UNREACHABLE if a
+    // landmark proves there is none
+    int lowerBound(int from, int to) const
+    {
+        int best = 0;
+        for (int l = 0; l < landmarkCount; l++)
+        {
+            const int *fromL = fromLandmark + l * portCount;
+            const int *toL = toLandmark + l * portCount;
+
+            if (toL[to] != UNREACHABLE)
+            {
+                if (toL[from] == UNREACHABLE)
+                    return UNREACHABLE; // from could reach L through to
+                if (toL[from] - toL[to] > best)
+                    best = toL[from] - toL[to];
+            }
+            if (fromL[from] != UNREACHABLE)
+            {
+                if (fromL[to] == UNREACHABLE)
+                    return UNREACHABLE; // L could reach to through from
+                if (fromL[to] - fromL[from] > best)
+                    best = fromL[to] - fromL[from];
+            }
+        }
+        return best;
+    }
+
+    bool saveToFile(const string &filename) const
+    {
+        ofstream file(filename, ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        const char magic[4] = {'A', 'L', 'T', '1'};
+        int cells = portCount * landmarkCount;
+        file.write(magic, 4);
+        file.write(reinterpret_cast<const char *>(&signature), sizeof(signature));
+        file.write(reinterpret_cast<const char *>(&portCount), sizeof(portCount));
+        file.write(reinterpret_cast<const char *>(&landmarkCount), sizeof(landmarkCount));
+        file.write(reinterpret_cast<const char *>(landmarks), sizeof(int) * landmarkCount);
+        file.write(reinterpret_cast<const char *>(fromLandmark), sizeof(int) * cells);
+        file.write(reinterpret_cast<const char *>(toLandmark), sizeof(int) * cells);
+        return file.good();
+    }
+
+    // Load tables saved by saveToFile; false (and nothing loaded) if the
+    // file is missing, damaged or was built for a different network
+    template <typename EdgeT>
+    bool loadFromFile(const string &filename, int ports, const int *edgeOffsets, const EdgeT *edges)
+    {
+        ifstream file(filename, ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        char magic[4];
+        unsigned int savedSignature = 0;
+        int savedPorts = 0, savedLandmarks = 0;
+        file.read(magic, 4);
+        file.read(reinterpret_cast<char *>(&savedSignature), sizeof(savedSignature));
+        file.read(reinterpret_cast<char *>(&savedPorts), sizeof(savedPorts));
+        file.read(reinterpret_cast<char *>(&savedLandmarks), sizeof(savedLandmarks));
+        if (!file || magic[0] != 'A' || magic[1] != 'L' || magic[2] != 'T' || magic[3] != '1' ||
+            savedPorts != ports || savedLandmarks < 0 || savedLandmarks > ports ||
+            savedSignature != signatureOf(ports, edgeOffsets, edges))
+        {
+            return false;
+        }
+
+        allocate(savedPorts, savedLandmarks);
+        signature = savedSignature;
+        int cells = portCount * landmarkCount;
+        file.read(reinterpret_cast<char *>(landmarks), sizeof(int) * landmarkCount);
+        file.read(reinterpret_cast<char *>(fromLandmark), sizeof(int) * cells);
+        file.read(reinterpret_cast<char *>(toLandmark), sizeof(int) * cells);
+        if (!file)
+        {
+            release();
+            return false;
+        }
+        return true;
+    }
+};
+
+#endif
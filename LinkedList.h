@@ -1,6 +1,7 @@
 
 #ifndef LINKEDLIST_H
 #define LINKEDLIST_H
+#include "NodePool.h"
 template <typename T>
 class LinkedList
 {
@@ -11,6 +12,7 @@ private:
         Node *next;
         Node(const T &value) : data(value), next(nullptr) {}
     };
+    NodePool<Node> pool; // Nodes are recycled instead of going back to the heap
     Node *head;
     Node *tail;
     int size;
@@ -48,7 +50,7 @@ public:
     }
     void push_back(const T &value)
     {
-        Node *newNode = new Node(value);
+        Node *newNode = pool.create(value);
         if (!head)
         {
             head = tail = newNode;
@@ -62,7 +64,7 @@ public:
     }
     void push_front(const T &value)
     {
-        Node *newNode = new Node(value);
+        Node *newNode = pool.create(value);
         newNode->next = head;
         head = newNode;
         if (!tail)
@@ -79,7 +81,7 @@ public:
         {
             Node *temp = head;
             head = head->next;
-            delete temp;
+            pool.destroy(temp);
             if (!head)
                 tail = nullptr;
             size--;
@@ -94,7 +96,7 @@ public:
         current->next = temp->next;
         if (temp == tail)
             tail = current;
-        delete temp;
+        pool.destroy(temp);
         size--;
         return true;
     }
@@ -136,7 +138,7 @@ public:
         {
             Node *temp = head;
             head = head->next;
-            delete temp;
+            pool.destroy(temp);
         }
         tail = nullptr;
         size = 0;
@@ -6,6 +6,7 @@
 #include <SFML/Graphics.hpp>
 #include "Graph.h"
 #include "LinkedList.h"
+#include "ArrayList.h"
 #include <string>
 #include <sstream>
 #include <cmath>
@@ -24,10 +25,10 @@ private:
     bool isHoveringRoute;
 
     // Subgraph filtering
-    LinkedList<string> filterCompanies; // Multiple companies filter
+    LinkedList<Symbol> filterCompanies; // Multiple companies filter
     string filterDate;
     bool isFiltered;
-    LinkedList<string> activePorts; // Ports that are part of filtered subgraph
+    ArrayList<string> activePorts; // Ports that are part of filtered subgraph
 
     // Visual settings
     const float PORT_RADIUS = 8.0f;
@@ -81,6 +82,15 @@ public:
     {
     }
 
+    // Draw a different graph, keeping the current filters (schedule reload)
+    void setGraph(Graph *g)
+    {
+        graph = g;
+        hoveredRouteIndex = -1;
+        isHoveringRoute = false;
+        updateActivePorts();
+    }
+
     // Set single company filter for subgraph
     void setCompanyFilter(const string &company)
     {
@@ -94,7 +104,7 @@ public:
     }
 
     // Set multiple companies filter
-    void setCompanyFilters(const LinkedList<string> &companies)
+    void setCompanyFilters(const LinkedList<Symbol> &companies)
     {
         filterCompanies = companies;
         isFiltered = companies.getSize() > 0;
@@ -173,7 +183,7 @@ public:
         if (!isFiltered)
             return;
 
-        LinkedList<Route> allRoutes = graph->getAllRoutes();
+        Graph::RouteView allRoutes = graph->getAllRoutes();
         for (int i = 0; i < allRoutes.getSize(); i++)
         {
             const Route &route = allRoutes.get(i);
@@ -250,7 +260,7 @@ public:
 
         // Check if hovering over any route
         isHoveringRoute = false;
-        LinkedList<Route> allRoutes = graph->getAllRoutes();
+        Graph::RouteView allRoutes = graph->getAllRoutes();
 
         for (int i = 0; i < allRoutes.getSize(); i++)
         {
@@ -355,7 +365,7 @@ public:
 private:
     void drawRoutes(sf::RenderWindow &window)
     {
-        LinkedList<Route> allRoutes = graph->getAllRoutes();
+        Graph::RouteView allRoutes = graph->getAllRoutes();
 
         for (int i = 0; i < allRoutes.getSize(); i++)
         {
@@ -429,7 +439,7 @@ private:
 
     void drawPorts(sf::RenderWindow &window)
     {
-        LinkedList<Port> allPorts = graph->getAllPorts();
+        ArrayList<Port> allPorts = graph->getAllPorts();
 
         for (int i = 0; i < allPorts.getSize(); i++)
         {
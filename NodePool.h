@@ -0,0 +1,84 @@
+#pragma once
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+#include <new>
+#include <utility>
+// Slab allocator for the nodes of one linked container. Nodes are carved
+// out of slabs of contiguous slots (16 at first, doubling up to 1024), and
+// released nodes go on a free list that create() takes from first, so a
+// container that keeps adding and removing (e.g. a docking queue) stops
+// calling the global heap once it has grown to its working size. Slabs are
+// only returned when the pool is destroyed.
+template <typename Node>
+class NodePool
+{
+private:
+    union Slot
+    {
+        Slot *next; // Next free slot, or (in a slab's first slot) the previous slab
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    static const int FIRST_SLAB = 16;
+    static const int MAX_SLAB = 1024;
+
+    Slot *slabs;    // Newest slab; slot 0 of each slab links to the one before
+    Slot *freeList;
+    int slabSize;   // Slots in the newest slab (including the link slot)
+    int slabUsed;   // Slots of the newest slab handed out so far
+
+    Slot *take()
+    {
+        if (freeList)
+        {
+            Slot *slot = freeList;
+            freeList = slot->next;
+            return slot;
+        }
+        if (slabs == nullptr || slabUsed == slabSize)
+        {
+            int size = (slabs == nullptr) ? FIRST_SLAB : slabSize * 2;
+            if (size > MAX_SLAB)
+            {
+                size = MAX_SLAB;
+            }
+            Slot *slab = new Slot[size];
+            slab[0].next = slabs;
+            slabs = slab;
+            slabSize = size;
+            slabUsed = 1;
+        }
+        return &slabs[slabUsed++];
+    }
+
+public:
+    NodePool() : slabs(nullptr), freeList(nullptr), slabSize(0), slabUsed(0) {}
+    // Every node must have been destroyed by then
+    ~NodePool()
+    {
+        while (slabs)
+        {
+            Slot *previous = slabs[0].next;
+            delete[] slabs;
+            slabs = previous;
+        }
+    }
+    NodePool(const NodePool &) = delete;
+    NodePool &operator=(const NodePool &) = delete;
+
+    template <typename... Args>
+    Node *create(Args &&...args)
+    {
+        Slot *slot = take();
+        return new (slot->storage) Node(std::forward<Args>(args)...);
+    }
+
+    void destroy(Node *node)
+    {
+        node->~Node();
+        Slot *slot = reinterpret_cast<Slot *>(node);
+        slot->next = freeList;
+        freeList = slot;
+    }
+};
+#endif
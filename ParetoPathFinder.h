@@ -0,0 +1,236 @@
+#pragma once
+#ifndef PARETO_PATH_FINDER_H
+#define PARETO_PATH_FINDER_H
+
+#include "TimeDependentRouter.h"
+#include "SearchWorkspace.h"
+using namespace std;
+// Multi-criteria search: one run returns every voyage that is not beaten
+// on all of total cost (sailings plus port charges), arrival time and
+// number of legs at once, instead of separate cheapest / fewest-legs runs.
+//
+// Labels live on sailings rather than ports, as in
+// TimeDependentRouter::findCheapestByDeadline: two labels on the same
+// sailing arrive at the same time and face the same layover charges, so
+// they can be compared on cost and legs alone. The labels waiting on a
+// sailing form a staircase (cheaper ones have more legs) and the frontier
+// holds each sailing once, at the cost of its cheapest waiting label.
+// Labels are settled in cost order, so a sailing only needs the fewest
+// legs settled on it so far. A label is dropped when its sailing cannot
+// lead to the destination, or when a voyage already found is no worse on
+// all three criteria even against the label's ReachabilityIndex lower
+// bounds for the rest of the way.
+class ParetoPathFinder
+{
+private:
+    struct Label
+    {
+        int edge;   // Packed edge index of the sailing this label ends with
+        int cost;
+        int legs;
+        int parent; // Label of the previous sailing, -1 for the first leg
+        int next;   // Next (dearer, fewer legs) label waiting on the same sailing
+    };
+
+    Graph *graph;
+    SearchWorkspace workspace; // Per-sailing arrays reused across queries
+
+    // Label pool, reused across queries
+    Label *labels;
+    int labelCount;
+    int labelCapacity;
+
+    int addLabel(int edge, int cost, int legs, int parent)
+    {
+        if (labelCount >= labelCapacity)
+        {
+            labelCapacity = (labelCapacity == 0) ? 256 : labelCapacity * 2;
+            Label *newLabels = new Label[labelCapacity];
+            for (int i = 0; i < labelCount; i++)
+            {
+                newLabels[i] = labels[i];
+            }
+            delete[] labels;
+            labels = newLabels;
+        }
+        Label &label = labels[labelCount];
+        label.edge = edge;
+        label.cost = cost;
+        label.legs = legs;
+        label.parent = parent;
+        label.next = -1;
+        return labelCount++;
+    }
+
+    // Queue a label on sailing edge unless one waiting or settled there is
+    // no worse; waiting labels it beats are unlinked
+    void offer(IndexedMinHeap<int> &frontier, StampedArray<int> &waiting, const StampedArray<int> &minLegs,
+               int edge, int cost, int legs, int parent)
+    {
+        if (minLegs.get(edge) <= legs)
+            return; // Settled no dearer and in as few legs
+
+        int before = -1; // Waiting label the new one goes after
+        int at = waiting.get(edge);
+        while (at != -1 && labels[at].cost <= cost)
+        {
+            if (labels[at].legs <= legs)
+                return;
+            before = at;
+            at = labels[at].next;
+        }
+        while (at != -1 && labels[at].legs >= legs)
+        {
+            at = labels[at].next; // Dearer and no fewer legs
+        }
+
+        int labelIdx = addLabel(edge, cost, legs, parent);
+        labels[labelIdx].next = at;
+        if (before == -1)
+        {
+            waiting[edge] = labelIdx;
+            frontier.pushOrDecrease(edge, cost);
+        }
+        else
+        {
+            labels[before].next = labelIdx;
+        }
+    }
+
+    // True if a destination label already found is no worse on every criterion
+    bool isDominated(const ArrayList<int> &found, int cost, int arrival, int legs) const
+    {
+        for (int i = 0; i < found.getSize(); i++)
+        {
+            const Label &other = labels[found.get(i)];
+            if (other.cost <= cost && graph->getEdge(other.edge).arrival <= arrival && other.legs <= legs)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    ParetoPathFinder(Graph *g) : graph(g), labels(nullptr), labelCount(0), labelCapacity(0) {}
+
+    ~ParetoPathFinder()
+    {
+        delete[] labels;
+    }
+
+    ParetoPathFinder(const ParetoPathFinder &) = delete;
+    ParetoPathFinder &operator=(const ParetoPathFinder &) = delete;
+
+    // Search a different graph from the next query on (schedule reload)
+    void setGraph(Graph *g) { graph = g; }
+
+    // Pareto frontier of voyages from origin to destination leaving at or
+    // after departAfter, cheapest first (so also latest-arriving / most
+    // legs first among the trade-offs)
+    ArrayList<PathResult> findParetoPaths(const string &origin, const string &destination, int departAfter)
+    {
+        ArrayList<PathResult> results;
+
+        int originIdx = graph->getPortId(origin);
+        int destIdx = graph->getPortId(destination);
+        if (originIdx == -1 || destIdx == -1 || originIdx == destIdx)
+        {
+            return results;
+        }
+
+        int numSailings = graph->getRouteCount();
+        StampedArray<int> &minLegs = workspace.ints(0, numSailings, numeric_limits<int>::max()); // Fewest legs settled on each sailing
+        StampedArray<int> &waiting = workspace.ints(1, numSailings, -1); // Cheapest waiting label per sailing
+        IndexedMinHeap<int> &frontier = workspace.frontier(0, numSailings); // Sailings by cheapest waiting label
+        const ReachabilityIndex &bounds = graph->getReachability();
+
+        labelCount = 0;
+        ArrayList<int> found; // Destination labels on the frontier
+
+        Graph::EdgeRange firstLegs = graph->getDeparturesAfter(originIdx, departAfter);
+        for (const Graph::Edge *edge = firstLegs.begin(); edge != firstLegs.end(); edge++)
+        {
+            if (edge->destination == -1 || !bounds.canReach(edge->destination, destIdx))
+                continue;
+            offer(frontier, waiting, minLegs, graph->getEdgeIndex(edge), edge->cost, 1, -1);
+        }
+
+        int sailingIdx, labelCost;
+        while (frontier.extractMin(sailingIdx, labelCost))
+        {
+            int labelIdx = waiting[sailingIdx];
+            Label label = labels[labelIdx];
+            waiting[sailingIdx] = label.next;
+            if (label.next != -1)
+            {
+                frontier.pushOrDecrease(sailingIdx, labels[label.next].cost);
+            }
+            if (minLegs[label.edge] <= label.legs)
+                continue; // Same sailing already reached as cheaply in as few legs
+
+            const Graph::Edge &sailing = graph->getEdge(label.edge);
+            if (isDominated(found, label.cost, sailing.arrival, label.legs))
+                continue;
+            minLegs[label.edge] = label.legs;
+
+            if (sailing.destination == destIdx)
+            {
+                // Equal cost can still leave an earlier entry beaten on legs
+                for (int i = found.getSize() - 1; i >= 0; i--)
+                {
+                    const Label &other = labels[found.get(i)];
+                    if (other.cost == label.cost && graph->getEdge(other.edge).arrival >= sailing.arrival &&
+                        other.legs >= label.legs)
+                    {
+                        found.remove(i);
+                    }
+                }
+                found.push_back(labelIdx);
+                continue;
+            }
+
+            const Port &layoverPort = graph->getPortById(sailing.destination);
+            Graph::EdgeRange departures = graph->getDeparturesAfter(sailing.destination, sailing.arrival);
+            for (const Graph::Edge *edge = departures.begin(); edge != departures.end(); edge++)
+            {
+                int nextIndex = graph->getEdgeIndex(edge);
+                int nextLegs = label.legs + 1;
+                if (edge->destination == -1 || minLegs[nextIndex] <= nextLegs ||
+                    !bounds.canReach(edge->destination, destIdx))
+                    continue;
+
+                int layoverHours = (edge->departure - sailing.arrival) / 60;
+                int nextCost = label.cost + edge->cost + TimeDependentRouter::layoverCharge(layoverPort, layoverHours);
+                if (isDominated(found, nextCost + bounds.getLowerBoundCost(edge->destination, destIdx),
+                                edge->arrival + bounds.getLowerBoundDuration(edge->destination, destIdx),
+                                nextLegs + bounds.getLowerBoundLegs(edge->destination, destIdx)))
+                    continue;
+
+                offer(frontier, waiting, minLegs, nextIndex, nextCost, nextLegs, labelIdx);
+            }
+        }
+
+        for (int i = 0; i < found.getSize(); i++)
+        {
+            ArrayList<int> chain;
+            for (int l = found.get(i); l != -1; l = labels[l].parent)
+            {
+                chain.push_back(graph->getEdge(labels[l].edge).routeIndex);
+            }
+            chain.reverse();
+            PathResult result;
+            TimeDependentRouter::buildResult(*graph, origin, chain, result);
+            results.push_back(result);
+        }
+
+        return results;
+    }
+
+    ArrayList<PathResult> findParetoPaths(const string &origin, const string &destination, const string &date)
+    {
+        return findParetoPaths(origin, destination, Route::toTimestamp(date, "00:00"));
+    }
+};
+
+#endif
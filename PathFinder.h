@@ -3,9 +3,11 @@
 #define PATHFINDER_H
 
 #include "Graph.h"
-#include "MinHeap.h"
+#include "IndexedMinHeap.h"
+#include "SearchWorkspace.h"
+#include "PreferenceMask.h"
 #include "LinkedList.h"
-#include "PortMapper.h"
+#include "ArrayList.h"
 #include "PreferenceFilter.h"
 #include <string>
 #include <limits>
@@ -13,7 +15,7 @@
 using namespace std;
 struct LayoverInfo
 {
-    string portName;
+    Symbol portName;
     int layoverHours;     // Total hours docked (including waiting)
     int portCharge;       // Charge only if > 12 hours
     string arrivalDate;   // Arrival date (DD/MM/YYYY)
@@ -21,9 +23,9 @@ struct LayoverInfo
     string departureDate; // Departure date (DD/MM/YYYY)
     string departureTime; // Departure time (HH:MM)
 
-    LayoverInfo() : portName(""), layoverHours(0), portCharge(0),
+    LayoverInfo() : portName(), layoverHours(0), portCharge(0),
                     arrivalDate(""), arrivalTime(""), departureDate(""), departureTime("") {}
-    LayoverInfo(const string &port, int hours, int charge,
+    LayoverInfo(const Symbol &port, int hours, int charge,
                 const string &arrDate, const string &arr, const string &depDate, const string &dep)
         : portName(port), layoverHours(hours), portCharge(charge),
           arrivalDate(arrDate), arrivalTime(arr), departureDate(depDate), departureTime(dep) {}
@@ -34,9 +36,9 @@ struct PathResult
     bool found;
     int totalCost;
     int totalTravelTime; // NEW: Total time in hours (travel + layover)
-    LinkedList<string> path;
-    LinkedList<Route> routes;
-    LinkedList<LayoverInfo> layovers; // Store layover information
+    ArrayList<Symbol> path; // Port names, interned
+    ArrayList<Route> routes;
+    ArrayList<LayoverInfo> layovers; // Store layover information
 
     PathResult() : found(false), totalCost(0), totalTravelTime(0) {}
 };
@@ -45,9 +47,11 @@ class PathFinder
 {
 private:
     Graph *graph;
+    SearchWorkspace workspace; // Search arrays reused across queries
+    PreferenceMask preferenceMask; // Preferences of the current query as bitsets
 
     // Helper to check if port is already in current path (avoid cycles)
-    bool isPortInPath(const LinkedList<string> &path, const string &port)
+    bool isPortInPath(const ArrayList<string> &path, const string &port)
     {
         for (int i = 0; i < path.getSize(); i++)
         {
@@ -63,8 +67,8 @@ private:
     void findAllPathsDFS(const string &current,
                          const string &destination,
                          const string &date,
-                         LinkedList<string> &currentPath,
-                         LinkedList<LinkedList<string>> &allPaths,
+                         ArrayList<string> &currentPath,
+                         ArrayList<ArrayList<string>> &allPaths,
                          int maxDepth = 10)
     {
 
@@ -87,7 +91,7 @@ private:
         }
 
         // Get all routes from current port on the given date
-        LinkedList<Route> routes = graph->getRoutesFromOnDate(current, date);
+        Graph::RouteView routes = graph->getRoutesFromOnDate(current, date);
 
         // Try each possible next destination
         for (int i = 0; i < routes.getSize(); i++)
@@ -107,7 +111,7 @@ private:
     }
 
     // Calculate total cost of a path
-    int calculatePathCost(const LinkedList<string> &path, const string &date)
+    int calculatePathCost(const ArrayList<string> &path, const string &date)
     {
         int totalCost = 0;
 
@@ -116,7 +120,7 @@ private:
             string from = path.get(i);
             string to = path.get(i + 1);
 
-            LinkedList<Route> routes = graph->getRoutesFromOnDate(from, date);
+            Graph::RouteView routes = graph->getRoutesFromOnDate(from, date);
 
             // Find the route from 'from' to 'to'
             bool found = false;
@@ -142,14 +146,17 @@ private:
 public:
     PathFinder(Graph *g) : graph(g) {}
 
+    // Search a different graph from the next query on (schedule reload)
+    void setGraph(Graph *g) { graph = g; }
+
     // NEW METHOD: Find all possible paths (for visualization)
-    LinkedList<LinkedList<string>> findAllPaths(const string &origin,
+    ArrayList<ArrayList<string>> findAllPaths(const string &origin,
                                                 const string &destination,
                                                 const string &date)
     {
 
-        LinkedList<LinkedList<string>> allPaths;
-        LinkedList<string> currentPath;
+        ArrayList<ArrayList<string>> allPaths;
+        ArrayList<string> currentPath;
 
         cout << "\n=== Finding ALL possible paths ===" << endl;
         cout << "Origin: " << origin << endl;
@@ -164,7 +171,7 @@ public:
         for (int i = 0; i < allPaths.getSize(); i++)
         {
             cout << "Path " << (i + 1) << ": ";
-            const LinkedList<string> &path = allPaths.get(i);
+            const ArrayList<string> &path = allPaths.get(i);
             for (int j = 0; j < path.getSize(); j++)
             {
                 cout << path.get(j);
@@ -182,11 +189,12 @@ public:
     // IMPROVED METHOD: Find cheapest path (Dijkstra's algorithm)
     PathResult findCheapestPath(const string &origin,
                                 const string &destination,
-                                const string &date)
+                                const string &date,
+                                bool goalDirected = false)
     {
         PathResult result;
 
-        cout << "\n=== Finding CHEAPEST path using Dijkstra ===" << endl;
+        cout << "\n=== Finding CHEAPEST path using " << (goalDirected ? "A*" : "Dijkstra") << " ===" << endl;
 
         // Validate ports exist
         if (!graph->hasPort(origin))
@@ -200,21 +208,13 @@ public:
             return result;
         }
 
-        // Build port mapper
-        PortMapper portMapper;
-        LinkedList<Port> allPorts = graph->getAllPorts();
-
-        for (int i = 0; i < allPorts.getSize(); i++)
-        {
-            portMapper.addPort(allPorts.get(i).name);
-        }
-
-        int numPorts = portMapper.getSize();
+        // Port IDs from the graph are dense, so they index the search arrays directly
+        int numPorts = graph->getVertexCount();
         cout << "Mapped " << numPorts << " ports" << endl;
 
         // Get indices
-        int originIdx = portMapper.findIndex(origin);
-        int destIdx = portMapper.findIndex(destination);
+        int originIdx = graph->getPortId(origin);
+        int destIdx = graph->getPortId(destination);
 
         if (originIdx == -1 || destIdx == -1)
         {
@@ -223,46 +223,30 @@ public:
         }
 
         // Arrays for Dijkstra with time-based routing
-        int *distances = new int[numPorts];
-        int *parent = new int[numPorts];
-        bool *visited = new bool[numPorts];
-        string *arrivalDates = new string[numPorts]; // Track arrival date at each port
-        string *arrivalTimes = new string[numPorts]; // Track arrival time at each port
-
-        for (int i = 0; i < numPorts; i++)
-        {
-            distances[i] = numeric_limits<int>::max();
-            parent[i] = -1;
-            visited[i] = false;
-            arrivalDates[i] = "";
-            arrivalTimes[i] = "";
-        }
+        StampedArray<int> &distances = workspace.ints(0, numPorts, numeric_limits<int>::max());
+        StampedArray<int> &parent = workspace.ints(1, numPorts, -1);
+        StampedArray<bool> &visited = workspace.flags(0, numPorts);
+        StampedArray<int> &arrivalStamps = workspace.ints(2, numPorts, -1); // Arrival timestamp at each port
 
         distances[originIdx] = 0;
-        arrivalDates[originIdx] = date;
-        arrivalTimes[originIdx] = "00:00"; // Start at beginning of day
+        arrivalStamps[originIdx] = Route::toTimestamp(date, "00:00"); // Start at beginning of day
 
         cout << "Running Dijkstra's algorithm with time-based routing..." << endl;
 
-        // Dijkstra's algorithm with time validation
-        for (int count = 0; count < numPorts; count++)
-        {
-            // Find minimum distance unvisited vertex
-            int minDist = numeric_limits<int>::max();
-            int minIdx = -1;
-
-            for (int i = 0; i < numPorts; i++)
-            {
-                if (!visited[i] && distances[i] < minDist)
-                {
-                    minDist = distances[i];
-                    minIdx = i;
-                }
-            }
+        // Frontier ordered by tentative cost; an improved port has its key
+        // decreased in place, so each port is queued at most once, O(E log V)
+        IndexedMinHeap<int> &frontier = workspace.frontier(0, numPorts);
+        frontier.pushOrDecrease(originIdx, 0);
 
-            if (minIdx == -1)
-                break; // No more reachable vertices
+        // A* mode orders the frontier by cost so far plus the precomputed
+        // cheapest sailing cost still needed, and never queues ports that
+        // cannot reach the destination. Plain Dijkstra leaves the tables unbuilt.
+        const ReachabilityIndex *bounds = goalDirected ? &graph->getReachability() : nullptr;
 
+        // Dijkstra's algorithm with time validation
+        int minIdx, minDist;
+        while (frontier.extractMin(minIdx, minDist))
+        {
             visited[minIdx] = true;
 
             // Found destination
@@ -275,75 +259,39 @@ public:
             }
 
             // Update neighbors with time-based validation
-            string currentPort = portMapper.getName(minIdx);
-            string currentArrivalDate = arrivalDates[minIdx];
-            string currentArrivalTime = arrivalTimes[minIdx];
+            int currentArrivalStamp = arrivalStamps[minIdx];
 
             // Get connecting routes (same day + future days) that are time-compatible
-            LinkedList<Route> connectingRoutes = graph->getConnectingRoutes(
-                currentPort, currentArrivalDate, currentArrivalTime);
+            Graph::EdgeRange connectingRoutes = graph->getDeparturesAfter(minIdx, currentArrivalStamp);
 
-            for (int i = 0; i < connectingRoutes.getSize(); i++)
+            for (const Graph::Edge *edge = connectingRoutes.begin(); edge != connectingRoutes.end(); edge++)
             {
-                const Route &route = connectingRoutes.get(i);
-                int neighborIdx = portMapper.findIndex(route.destination);
+                const Route &route = graph->getRouteByIndex(edge->routeIndex);
+                int neighborIdx = edge->destination;
 
                 if (neighborIdx == -1 || visited[neighborIdx])
                     continue;
+                if (bounds && !bounds->canReach(neighborIdx, destIdx))
+                    continue;
 
-                // Calculate layover hours and validate connection
+                // Wait since arriving here (every departure in the range leaves at or
+                // after that arrival); the origin has no layover
                 int layoverHours = 0;
-                bool connectionValid = true;
-
-                // Find and validate the previous route if exists
                 if (parent[minIdx] != -1)
                 {
-                    string fromPort = portMapper.getName(parent[minIdx]);
-                    string toPort = currentPort;
-                    string prevArrivalDate = arrivalDates[minIdx];
-                    string prevArrivalTime = arrivalTimes[minIdx];
-
-                    // Find the route that was used to reach currentPort
-                    LinkedList<Route> prevRoutes = graph->getConnectingRoutes(fromPort, arrivalDates[parent[minIdx]], arrivalTimes[parent[minIdx]]);
-                    for (int j = 0; j < prevRoutes.getSize(); j++)
-                    {
-                        if (prevRoutes.get(j).destination == toPort &&
-                            prevRoutes.get(j).date == prevArrivalDate)
-                        {
-                            // Validate connection inline while prevRoutes is still in scope
-                            const Route &previousRoute = prevRoutes.get(j);
-                            if (!previousRoute.canConnectTo(route))
-                            {
-                                connectionValid = false;
-                            }
-                            else
-                            {
-                                layoverHours = Route::calculateLayoverHours(previousRoute, route);
-                            }
-                            break;
-                        }
-                    }
-                }
-
-                // Skip if connection is invalid
-                if (!connectionValid)
-                {
-                    continue;
+                    layoverHours = (edge->departure - currentArrivalStamp) / 60;
                 }
 
                 // Apply port charge only for layovers > 12 hours
                 int portCharge = 0;
                 if (layoverHours > 12)
                 {
-                    Port currentPortInfo;
-                    if (graph->getPort(currentPort, currentPortInfo))
-                    {
-                        // Calculate number of days (round up)
-                        int days = (layoverHours + 11) / 24; // Round up to nearest day
-                        if (days == 0)
-                            days = 1; // At least 1 day for layover > 12 hours
-                        portCharge = currentPortInfo.dailyCharge * days;
-                    }
+                    const Port &currentPortInfo = graph->getPortById(minIdx);
+                    // Calculate number of days (round up)
+                    int days = (layoverHours + 11) / 24; // Round up to nearest day
+                    if (days == 0)
+                        days = 1; // At least 1 day for layover > 12 hours
+                    portCharge = currentPortInfo.dailyCharge * days;
                 }
 
                 // Calculate total cost: route cost + port charge (only for layovers > 12h)
@@ -352,8 +300,9 @@ public:
                 {
                     distances[neighborIdx] = newDist;
                     parent[neighborIdx] = minIdx;
-                    arrivalDates[neighborIdx] = route.date;
-                    arrivalTimes[neighborIdx] = route.arrivalTime;
+                    arrivalStamps[neighborIdx] = route.arrivalStamp;
+                    frontier.pushOrDecrease(neighborIdx, bounds ? newDist + bounds->getLowerBoundCost(neighborIdx, destIdx)
+                                                                : newDist);
                 }
             }
         }
@@ -363,7 +312,7 @@ public:
         {
             cout << "Reconstructing optimal path..." << endl;
 
-            LinkedList<int> pathIndices;
+            ArrayList<int> pathIndices;
             int current = destIdx;
             while (current != -1)
             {
@@ -374,7 +323,7 @@ public:
             // Reverse to get correct order
             for (int i = pathIndices.getSize() - 1; i >= 0; i--)
             {
-                result.path.push_back(portMapper.getName(pathIndices.get(i)));
+                result.path.push_back(graph->getPortName(pathIndices.get(i)));
             }
 
             // Reconstruct routes by querying the graph
@@ -382,17 +331,16 @@ public:
             {
                 int fromIdx = pathIndices.get(i);
                 int toIdx = pathIndices.get(i - 1);
-                string fromPort = portMapper.getName(fromIdx);
-                string toPort = portMapper.getName(toIdx);
-                string departDate = arrivalDates[fromIdx];
-                string departTime = arrivalTimes[fromIdx];
-                string arriveDate = arrivalDates[toIdx];
+                string fromPort = graph->getPortName(fromIdx);
+                string toPort = graph->getPortName(toIdx);
+                int departStamp = arrivalStamps[fromIdx];
+                int arriveStamp = arrivalStamps[toIdx];
 
                 // Find the route used
-                LinkedList<Route> routes = graph->getConnectingRoutes(fromPort, departDate, departTime);
+                Graph::RouteView routes = graph->getConnectingRoutes(fromPort, departStamp);
                 for (int j = 0; j < routes.getSize(); j++)
                 {
-                    if (routes.get(j).destination == toPort && routes.get(j).date == arriveDate)
+                    if (routes.get(j).destination == toPort && routes.get(j).arrivalStamp == arriveStamp)
                     {
                         result.routes.push_back(routes.get(j));
                         break;
@@ -426,7 +374,7 @@ public:
                 }
 
                 LayoverInfo layover(layoverPort, layoverHours, portCharge,
-                                    arrivingRoute.date, arrivingRoute.arrivalTime,
+                                    Route::dateFromTimestamp(arrivingRoute.arrivalStamp), arrivingRoute.arrivalTime,
                                     departingRoute.date, departingRoute.departureTime);
                 result.layovers.push_back(layover);
             }
@@ -487,19 +435,9 @@ public:
             }
             cout << "  Total Cost: $" << result.totalCost << endl;
 
-            // Calculate total travel time (route times + layover times)
-            int totalTravelHours = 0;
-            for (int i = 0; i < result.routes.getSize(); i++)
-            {
-                const Route &route = result.routes.get(i);
-                // Each route takes approximately 24 hours (1 day travel)
-                totalTravelHours += 24;
-            }
-            // Add layover hours
-            for (int i = 0; i < result.layovers.getSize(); i++)
-            {
-                totalTravelHours += result.layovers.get(i).layoverHours;
-            }
+            // Total travel time: first departure to final arrival (sailing + layovers)
+            int totalTravelHours = (result.routes.get(result.routes.getSize() - 1).arrivalStamp -
+                                    result.routes.get(0).departureStamp) / 60;
             result.totalTravelTime = totalTravelHours;
             cout << "  Total Travel Time: " << totalTravelHours << " hours ("
                  << (totalTravelHours / 24) << " days " << (totalTravelHours % 24) << " hours)" << endl;
@@ -509,30 +447,26 @@ public:
             cout << "No path found to destination!" << endl;
         }
 
-        delete[] distances;
-        delete[] parent;
-        delete[] visited;
-        delete[] arrivalDates;
-        delete[] arrivalTimes;
-
         return result;
     }
 
     bool hasRoutesOnDate(const string &origin, const string &date)
     {
-        LinkedList<Route> routes = graph->getRoutesFromOnDate(origin, date);
+        Graph::RouteView routes = graph->getRoutesFromOnDate(origin, date);
         return routes.getSize() > 0;
     }
 
-    // Find cheapest path with user preferences (Dijkstra's algorithm with filtering)
+    // Find cheapest path with user preferences (Dijkstra's algorithm with
+    // filtering); goalDirected runs it as A*, as in findCheapestPath
     PathResult findCheapestPathWithPreferences(const string &origin,
                                                const string &destination,
                                                const string &date,
-                                               const PreferenceFilter &preferences)
+                                               const PreferenceFilter &preferences,
+                                               bool goalDirected = false)
     {
         PathResult result;
 
-        cout << "\n=== Finding CHEAPEST path with PREFERENCES using Dijkstra ===" << endl;
+        cout << "\n=== Finding CHEAPEST path with PREFERENCES using " << (goalDirected ? "A*" : "Dijkstra") << " ===" << endl;
 
         // Validate ports exist
         if (!graph->hasPort(origin))
@@ -546,21 +480,13 @@ public:
             return result;
         }
 
-        // Build port mapper
-        PortMapper portMapper;
-        LinkedList<Port> allPorts = graph->getAllPorts();
-
-        for (int i = 0; i < allPorts.getSize(); i++)
-        {
-            portMapper.addPort(allPorts.get(i).name);
-        }
-
-        int numPorts = portMapper.getSize();
+        // Interned port IDs from the graph
+        int numPorts = graph->getVertexCount();
         cout << "Mapped " << numPorts << " ports" << endl;
 
         // Get indices
-        int originIdx = portMapper.findIndex(origin);
-        int destIdx = portMapper.findIndex(destination);
+        int originIdx = graph->getPortId(origin);
+        int destIdx = graph->getPortId(destination);
 
         if (originIdx == -1 || destIdx == -1)
         {
@@ -569,46 +495,30 @@ public:
         }
 
         // Arrays for Dijkstra with time-based routing and preferences
-        int *distances = new int[numPorts];
-        int *parent = new int[numPorts];
-        bool *visited = new bool[numPorts];
-        string *arrivalDates = new string[numPorts];
-        string *arrivalTimes = new string[numPorts];
+        StampedArray<int> &distances = workspace.ints(0, numPorts, numeric_limits<int>::max());
+        StampedArray<int> &parent = workspace.ints(1, numPorts, -1);
+        StampedArray<bool> &visited = workspace.flags(0, numPorts);
+        StampedArray<int> &arrivalStamps = workspace.ints(2, numPorts, -1); // Arrival timestamp at each port
 
-        for (int i = 0; i < numPorts; i++)
-        {
-            distances[i] = numeric_limits<int>::max();
-            parent[i] = -1;
-            visited[i] = false;
-            arrivalDates[i] = "";
-            arrivalTimes[i] = "";
-        }
+        // Preferences as bitsets over port and company IDs
+        preferenceMask.compile(preferences, *graph);
 
         distances[originIdx] = 0;
-        arrivalDates[originIdx] = date;
-        arrivalTimes[originIdx] = "00:00";
+        arrivalStamps[originIdx] = Route::toTimestamp(date, "00:00"); // Start at beginning of day
 
         cout << "Running Dijkstra's algorithm with preference filtering and time-based routing..." << endl;
 
-        // Dijkstra's algorithm with preference filtering and time validation
-        for (int count = 0; count < numPorts; count++)
-        {
-            // Find minimum distance unvisited vertex
-            int minDist = numeric_limits<int>::max();
-            int minIdx = -1;
-
-            for (int i = 0; i < numPorts; i++)
-            {
-                if (!visited[i] && distances[i] < minDist)
-                {
-                    minDist = distances[i];
-                    minIdx = i;
-                }
-            }
+        // Decrease-key frontier, as in findCheapestPath
+        IndexedMinHeap<int> &frontier = workspace.frontier(0, numPorts);
+        frontier.pushOrDecrease(originIdx, 0);
 
-            if (minIdx == -1)
-                break; // No more reachable vertices
+        // Unfiltered bounds stay admissible: preferences only remove sailings
+        const ReachabilityIndex *bounds = goalDirected ? &graph->getReachability() : nullptr;
 
+        // Dijkstra's algorithm with preference filtering and time validation
+        int minIdx, minDist;
+        while (frontier.extractMin(minIdx, minDist))
+        {
             visited[minIdx] = true;
 
             // Found destination
@@ -621,97 +531,45 @@ public:
             }
 
             // Update neighbors with preference filtering and time validation
-            string currentPort = portMapper.getName(minIdx);
-            string currentArrivalDate = arrivalDates[minIdx];
-            string currentArrivalTime = arrivalTimes[minIdx];
+            int currentArrivalStamp = arrivalStamps[minIdx];
 
             // Get connecting routes (same day + next day) that are time-compatible
-            LinkedList<Route> connectingRoutes = graph->getConnectingRoutes(
-                currentPort, currentArrivalDate, currentArrivalTime);
+            Graph::EdgeRange connectingRoutes = graph->getDeparturesAfter(minIdx, currentArrivalStamp);
 
-            for (int i = 0; i < connectingRoutes.getSize(); i++)
+            for (const Graph::Edge *edge = connectingRoutes.begin(); edge != connectingRoutes.end(); edge++)
             {
-                const Route &route = connectingRoutes.get(i);
-
                 // Apply preference filter
-                if (!preferences.matchesRoute(route))
+                if (!preferenceMask.allows(minIdx, *edge))
                 {
                     continue; // Skip routes that don't match preferences
                 }
 
-                int neighborIdx = portMapper.findIndex(route.destination);
+                const Route &route = graph->getRouteByIndex(edge->routeIndex);
+
+                int neighborIdx = edge->destination;
 
                 if (neighborIdx == -1 || visited[neighborIdx])
                     continue;
+                if (bounds && !bounds->canReach(neighborIdx, destIdx))
+                    continue;
 
-                // Check if neighbor is excluded
-                if (preferences.hasPortPreference)
-                {
-                    bool isExcluded = false;
-                    for (int j = 0; j < preferences.excludedPorts.getSize(); j++)
-                    {
-                        if (portMapper.getName(neighborIdx) == preferences.excludedPorts.get(j))
-                        {
-                            isExcluded = true;
-                            break;
-                        }
-                    }
-                    if (isExcluded)
-                        continue;
-                }
-
-                // Calculate layover hours and validate connection
+                // Wait since arriving here (every departure in the range leaves at or
+                // after that arrival); the origin has no layover
                 int layoverHours = 0;
-                bool connectionValid = true;
-
-                // Find and validate the previous route if exists
                 if (parent[minIdx] != -1)
                 {
-                    string fromPort = portMapper.getName(parent[minIdx]);
-                    string toPort = currentPort;
-                    string prevArrivalDate = arrivalDates[minIdx];
-                    string prevArrivalTime = arrivalTimes[minIdx];
-
-                    // Find the route that was used to reach currentPort
-                    LinkedList<Route> prevRoutes = graph->getConnectingRoutes(fromPort, arrivalDates[parent[minIdx]], arrivalTimes[parent[minIdx]]);
-                    for (int j = 0; j < prevRoutes.getSize(); j++)
-                    {
-                        if (prevRoutes.get(j).destination == toPort &&
-                            prevRoutes.get(j).date == prevArrivalDate)
-                        {
-                            // Validate connection inline while prevRoutes is still in scope
-                            const Route &previousRoute = prevRoutes.get(j);
-                            if (!previousRoute.canConnectTo(route))
-                            {
-                                connectionValid = false;
-                            }
-                            else
-                            {
-                                layoverHours = Route::calculateLayoverHours(previousRoute, route);
-                            }
-                            break;
-                        }
-                    }
-                }
-
-                // Skip if connection is invalid
-                if (!connectionValid)
-                {
-                    continue;
+                    layoverHours = (edge->departure - currentArrivalStamp) / 60;
                 }
 
                 // Apply port charge only for layovers > 12 hours
                 int portCharge = 0;
                 if (layoverHours > 12)
                 {
-                    Port currentPortInfo;
-                    if (graph->getPort(currentPort, currentPortInfo))
-                    {
-                        int days = (layoverHours + 11) / 24;
-                        if (days == 0)
-                            days = 1;
-                        portCharge = currentPortInfo.dailyCharge * days;
-                    }
+                    const Port &currentPortInfo = graph->getPortById(minIdx);
+                    int days = (layoverHours + 11) / 24;
+                    if (days == 0)
+                        days = 1;
+                    portCharge = currentPortInfo.dailyCharge * days;
                 }
 
                 // Calculate total cost: route cost + port charge (only for layovers > 12h)
@@ -720,8 +578,9 @@ public:
                 {
                     distances[neighborIdx] = newDist;
                     parent[neighborIdx] = minIdx;
-                    arrivalDates[neighborIdx] = route.date;
-                    arrivalTimes[neighborIdx] = route.arrivalTime;
+                    arrivalStamps[neighborIdx] = route.arrivalStamp;
+                    frontier.pushOrDecrease(neighborIdx, bounds ? newDist + bounds->getLowerBoundCost(neighborIdx, destIdx)
+                                                                : newDist);
                 }
             }
         }
@@ -731,7 +590,7 @@ public:
         {
             cout << "Reconstructing optimal path..." << endl;
 
-            LinkedList<int> pathIndices;
+            ArrayList<int> pathIndices;
             int current = destIdx;
             while (current != -1)
             {
@@ -742,7 +601,7 @@ public:
             // Reverse to get correct order
             for (int i = pathIndices.getSize() - 1; i >= 0; i--)
             {
-                result.path.push_back(portMapper.getName(pathIndices.get(i)));
+                result.path.push_back(graph->getPortName(pathIndices.get(i)));
             }
 
             // Check if path includes required ports
@@ -760,17 +619,16 @@ public:
             {
                 int fromIdx = pathIndices.get(i);
                 int toIdx = pathIndices.get(i - 1);
-                string fromPort = portMapper.getName(fromIdx);
-                string toPort = portMapper.getName(toIdx);
-                string departDate = arrivalDates[fromIdx];
-                string departTime = arrivalTimes[fromIdx];
-                string arriveDate = arrivalDates[toIdx];
+                string fromPort = graph->getPortName(fromIdx);
+                string toPort = graph->getPortName(toIdx);
+                int departStamp = arrivalStamps[fromIdx];
+                int arriveStamp = arrivalStamps[toIdx];
 
                 // Find the route used
-                LinkedList<Route> routes = graph->getConnectingRoutes(fromPort, departDate, departTime);
+                Graph::RouteView routes = graph->getConnectingRoutes(fromPort, departStamp);
                 for (int j = 0; j < routes.getSize(); j++)
                 {
-                    if (routes.get(j).destination == toPort && routes.get(j).date == arriveDate)
+                    if (routes.get(j).destination == toPort && routes.get(j).arrivalStamp == arriveStamp)
                     {
                         result.routes.push_back(routes.get(j));
                         break;
@@ -811,7 +669,7 @@ public:
                 }
 
                 LayoverInfo layover(layoverPort, layoverHours, portCharge,
-                                    arrivingRoute.date, arrivingRoute.arrivalTime,
+                                    Route::dateFromTimestamp(arrivingRoute.arrivalStamp), arrivingRoute.arrivalTime,
                                     departingRoute.date, departingRoute.departureTime);
                 result.layovers.push_back(layover);
             }
@@ -872,19 +730,9 @@ public:
             }
             cout << "  Total Cost: $" << result.totalCost << endl;
 
-            // Calculate total travel time (route times + layover times)
-            int totalTravelHours = 0;
-            for (int i = 0; i < result.routes.getSize(); i++)
-            {
-                const Route &route = result.routes.get(i);
-                // Each route takes approximately 24 hours (1 day travel)
-                totalTravelHours += 24;
-            }
-            // Add layover hours
-            for (int i = 0; i < result.layovers.getSize(); i++)
-            {
-                totalTravelHours += result.layovers.get(i).layoverHours;
-            }
+            // Total travel time: first departure to final arrival (sailing + layovers)
+            int totalTravelHours = (result.routes.get(result.routes.getSize() - 1).arrivalStamp -
+                                    result.routes.get(0).departureStamp) / 60;
             result.totalTravelTime = totalTravelHours;
             cout << "  Total Travel Time: " << totalTravelHours << " hours ("
                  << (totalTravelHours / 24) << " days " << (totalTravelHours % 24) << " hours)" << endl;
@@ -894,37 +742,23 @@ public:
             cout << "No path found to destination with given preferences!" << endl;
         }
 
-        delete[] distances;
-        delete[] parent;
-        delete[] visited;
-        delete[] arrivalDates;
-        delete[] arrivalTimes;
-
         return result;
     }
 
     // Get all connecting routes that match preferences
-    LinkedList<Route> getAllConnectingRoutesWithPreferences(const string &origin,
+    ArrayList<Route> getAllConnectingRoutesWithPreferences(const string &origin,
                                                             const string &destination,
                                                             const string &date,
                                                             const PreferenceFilter &preferences)
     {
-        LinkedList<Route> connectingRoutes;
+        ArrayList<Route> connectingRoutes;
 
         cout << "\n=== Getting ALL connecting routes with PREFERENCES ===" << endl;
         cout << "From: " << origin << " To: " << destination << endl;
 
-        // Build port mapper
-        PortMapper portMapper;
-        LinkedList<Port> allPorts = graph->getAllPorts();
-
-        for (int i = 0; i < allPorts.getSize(); i++)
-        {
-            portMapper.addPort(allPorts.get(i).name);
-        }
-
-        int originIdx = portMapper.findIndex(origin);
-        int destIdx = portMapper.findIndex(destination);
+        // Interned port IDs from the graph
+        int originIdx = graph->getPortId(origin);
+        int destIdx = graph->getPortId(destination);
 
         if (originIdx == -1)
         {
@@ -937,68 +771,19 @@ public:
             return connectingRoutes;
         }
 
-        int numPorts = portMapper.getSize();
-
-        // BFS from destination backwards to find all ports that can reach destination
-        Queue<int> queue;
-        bool *canReachDest = new bool[numPorts];
-        bool *visited = new bool[numPorts];
-
-        for (int i = 0; i < numPorts; i++)
-        {
-            canReachDest[i] = false;
-            visited[i] = false;
-        }
-
-        // Start BFS from destination (reverse direction)
-        queue.enqueue(destIdx);
-        visited[destIdx] = true;
-        canReachDest[destIdx] = true;
-
-        while (!queue.isEmpty())
-        {
-            int currentIdx = queue.getFront();
-            queue.dequeue();
-
-            string currentPort = portMapper.getName(currentIdx);
-
-            // Find all ports that have routes TO current port (includes multi-day routes)
-            for (int i = 0; i < allPorts.getSize(); i++)
-            {
-                string potentialPort = allPorts.get(i).name;
-                // Get all routes from potential port (includes multi-day routes)
-                LinkedList<Route> routes = graph->getRoutesFrom(potentialPort);
-
-                for (int j = 0; j < routes.getSize(); j++)
-                {
-                    const Route &route = routes.get(j);
+        int numPorts = graph->getVertexCount();
 
-                    // Apply preference filter
-                    if (!preferences.matchesRoute(route))
-                    {
-                        continue;
-                    }
-
-                    if (route.destination == currentPort)
-                    {
-                        int potentialIdx = portMapper.findIndex(potentialPort);
-                        if (potentialIdx != -1 && !visited[potentialIdx])
-                        {
-                            visited[potentialIdx] = true;
-                            canReachDest[potentialIdx] = true;
-                            queue.enqueue(potentialIdx);
-                        }
-                    }
-                }
-            }
-        }
+        // Ports that can reach destination using only the preferred companies
+        // and avoiding excluded ports (reverse BFS over precomputed bitsets)
+        preferenceMask.compile(preferences, *graph);
+        int numCompanies = graph->getCompanyCount();
+        bool *canReachDest = workspace.buffer(0, numPorts);
+        const bool *allowedCompanies = preferenceMask.fillAllowedCompanies(workspace.buffer(1, numCompanies), numCompanies);
+        const bool *excludedPorts = preferenceMask.fillExcludedPorts(workspace.buffer(2, numPorts), numPorts);
+        graph->getReachability().findPortsReaching(destIdx, allowedCompanies, excludedPorts, canReachDest);
 
         // Now BFS from origin to collect routes that can eventually reach destination
-        bool *originVisited = new bool[numPorts];
-        for (int i = 0; i < numPorts; i++)
-        {
-            originVisited[i] = false;
-        }
+        StampedArray<bool> &originVisited = workspace.flags(0, numPorts);
 
         Queue<int> originQueue;
         originQueue.enqueue(originIdx);
@@ -1009,21 +794,21 @@ public:
             int currentIdx = originQueue.getFront();
             originQueue.dequeue();
 
-            string currentPort = portMapper.getName(currentIdx);
+            string currentPort = graph->getPortName(currentIdx);
             // Get all routes from current port (includes multi-day routes)
-            LinkedList<Route> routes = graph->getRoutesFrom(currentPort);
+            Graph::RouteView routes = graph->getRoutesFrom(currentPort);
 
-            for (int i = 0; i < routes.getSize(); i++)
+            for (Graph::RouteView::Iterator it = routes.begin(); it != routes.end(); ++it)
             {
-                const Route &route = routes.get(i);
+                const Route &route = *it;
 
                 // Apply preference filter
-                if (!preferences.matchesRoute(route))
+                if (!preferenceMask.allows(currentIdx, it.getEdge()))
                 {
                     continue;
                 }
 
-                int routeDestIdx = portMapper.findIndex(route.destination);
+                int routeDestIdx = it.getEdge().destination;
 
                 // Only include routes that lead to ports that can reach destination
                 if (routeDestIdx != -1 && canReachDest[routeDestIdx])
@@ -1060,34 +845,22 @@ public:
         cout << "Found " << connectingRoutes.getSize()
              << " connecting routes that match preferences and can reach " << destination << endl;
 
-        delete[] canReachDest;
-        delete[] visited;
-        delete[] originVisited;
-
         return connectingRoutes;
     }
 
     // Get all connecting routes that can eventually reach destination
-    LinkedList<Route> getAllConnectingRoutes(const string &origin,
+    ArrayList<Route> getAllConnectingRoutes(const string &origin,
                                              const string &destination,
                                              const string &date)
     {
-        LinkedList<Route> connectingRoutes;
+        ArrayList<Route> connectingRoutes;
 
         cout << "\n=== Getting ALL connecting routes ===" << endl;
         cout << "From: " << origin << " To: " << destination << endl;
 
-        // Build port mapper
-        PortMapper portMapper;
-        LinkedList<Port> allPorts = graph->getAllPorts();
-
-        for (int i = 0; i < allPorts.getSize(); i++)
-        {
-            portMapper.addPort(allPorts.get(i).name);
-        }
-
-        int originIdx = portMapper.findIndex(origin);
-        int destIdx = portMapper.findIndex(destination);
+        // Interned port IDs from the graph
+        int originIdx = graph->getPortId(origin);
+        int destIdx = graph->getPortId(destination);
 
         if (originIdx == -1)
         {
@@ -1100,62 +873,14 @@ public:
             return connectingRoutes;
         }
 
-        int numPorts = portMapper.getSize();
-
-        // BFS from destination backwards to find all ports that can reach destination
-        Queue<int> queue;
-        bool *canReachDest = new bool[numPorts];
-        bool *visited = new bool[numPorts];
-
-        for (int i = 0; i < numPorts; i++)
-        {
-            canReachDest[i] = false;
-            visited[i] = false;
-        }
-
-        // Start BFS from destination (reverse direction)
-        queue.enqueue(destIdx);
-        visited[destIdx] = true;
-        canReachDest[destIdx] = true;
-
-        while (!queue.isEmpty())
-        {
-            int currentIdx = queue.getFront();
-            queue.dequeue();
-
-            string currentPort = portMapper.getName(currentIdx);
+        int numPorts = graph->getVertexCount();
 
-            // Find all ports that have routes TO current port
-            for (int i = 0; i < allPorts.getSize(); i++)
-            {
-                string potentialPort = allPorts.get(i).name;
-                // Get all routes from potential port (includes multi-day routes)
-                LinkedList<Route> allFromPotential = graph->getRoutesFrom(potentialPort);
-
-                for (int j = 0; j < allFromPotential.getSize(); j++)
-                {
-                    const Route &route = allFromPotential.get(j);
-                    // Check if this route leads to current port
-                    if (route.destination == currentPort)
-                    {
-                        int potentialIdx = portMapper.findIndex(potentialPort);
-                        if (potentialIdx != -1 && !visited[potentialIdx])
-                        {
-                            visited[potentialIdx] = true;
-                            canReachDest[potentialIdx] = true;
-                            queue.enqueue(potentialIdx);
-                        }
-                    }
-                }
-            }
-        }
+        // Ports that can reach destination (precomputed reachability)
+        bool *canReachDest = workspace.buffer(0, numPorts);
+        graph->getReachability().findPortsReaching(destIdx, nullptr, nullptr, canReachDest);
 
         // Now BFS from origin to collect routes that can eventually reach destination
-        bool *originVisited = new bool[numPorts];
-        for (int i = 0; i < numPorts; i++)
-        {
-            originVisited[i] = false;
-        }
+        StampedArray<bool> &originVisited = workspace.flags(0, numPorts);
 
         Queue<int> originQueue;
         originQueue.enqueue(originIdx);
@@ -1166,14 +891,14 @@ public:
             int currentIdx = originQueue.getFront();
             originQueue.dequeue();
 
-            string currentPort = portMapper.getName(currentIdx);
+            string currentPort = graph->getPortName(currentIdx);
             // Get all routes from current port (includes multi-day routes)
-            LinkedList<Route> allRoutes = graph->getRoutesFrom(currentPort);
+            Graph::RouteView allRoutes = graph->getRoutesFrom(currentPort);
 
             for (int i = 0; i < allRoutes.getSize(); i++)
             {
                 const Route &route = allRoutes.get(i);
-                int routeDestIdx = portMapper.findIndex(route.destination);
+                int routeDestIdx = graph->getPortId(route.destination);
 
                 // Only include routes that lead to ports that can reach destination
                 if (routeDestIdx != -1 && canReachDest[routeDestIdx])
@@ -1210,10 +935,6 @@ public:
         cout << "Found " << connectingRoutes.getSize()
              << " connecting routes that can reach " << destination << endl;
 
-        delete[] canReachDest;
-        delete[] visited;
-        delete[] originVisited;
-
         return connectingRoutes;
     }
 
@@ -1255,7 +976,7 @@ public:
         }
 
         // Build complete path sequence
-        LinkedList<string> fullPath;
+        ArrayList<string> fullPath;
         fullPath.push_back(origin);
         for (int i = 0; i < intermediatePorts.getSize(); i++)
         {
@@ -1274,8 +995,8 @@ public:
 
             cout << "Finding route from " << from << " to " << to << "..." << endl;
 
-            // Use Dijkstra to find cheapest path for this leg
-            PathResult legResult = findCheapestPath(from, to, date);
+            // Use A* to find cheapest path for this leg
+            PathResult legResult = findCheapestPath(from, to, date, true);
 
             if (!legResult.found)
             {
@@ -1334,14 +1055,25 @@ public:
         return result;
     }
 
-    // Bidirectional Dijkstra search for efficiency
+    // Bidirectional ALT search.
+    //
+    // The forward search is the timed search of findCheapestPath, ordered by
+    // cost so far plus the landmark lower bound to the destination. The
+    // backward search runs from the destination over the reverse adjacency
+    // with plain sailing costs (never more than a real leg, which may add
+    // waiting charges), ordered by its distance plus the landmark bound from
+    // the origin. Once the forward search has reached the destination at
+    // cost mu, the backward search goes on until its smallest key reaches
+    // mu; a port it has not settled by then cannot lie on a cheaper voyage,
+    // so the forward search stops expanding it. The forward search ends when
+    // it settles the destination, so the voyage is always a timed one.
     PathResult findCheapestPathBidirectional(const string &origin,
                                              const string &destination,
                                              const string &date)
     {
         PathResult result;
 
-        cout << "\n=== Finding CHEAPEST path using BIDIRECTIONAL Dijkstra ===" << endl;
+        cout << "\n=== Finding CHEAPEST path using BIDIRECTIONAL ALT ===" << endl;
 
         // Validate ports exist
         if (!graph->hasPort(origin))
@@ -1355,17 +1087,10 @@ public:
             return result;
         }
 
-        // Build port mapper
-        PortMapper portMapper;
-        LinkedList<Port> allPorts = graph->getAllPorts();
-        for (int i = 0; i < allPorts.getSize(); i++)
-        {
-            portMapper.addPort(allPorts.get(i).name);
-        }
-
-        int numPorts = portMapper.getSize();
-        int originIdx = portMapper.findIndex(origin);
-        int destIdx = portMapper.findIndex(destination);
+        // Interned port IDs from the graph
+        int numPorts = graph->getVertexCount();
+        int originIdx = graph->getPortId(origin);
+        int destIdx = graph->getPortId(destination);
 
         if (originIdx == -1 || destIdx == -1)
         {
@@ -1373,258 +1098,143 @@ public:
             return result;
         }
 
-        // Forward search from origin
-        int *forwardDist = new int[numPorts];
-        int *forwardParent = new int[numPorts];
-        bool *forwardVisited = new bool[numPorts];
-        string *forwardArrivalDates = new string[numPorts];
-        string *forwardArrivalTimes = new string[numPorts];
+        // Forward search from origin (timed)
+        StampedArray<int> &forwardDist = workspace.ints(0, numPorts, numeric_limits<int>::max());
+        StampedArray<int> &forwardParentEdge = workspace.ints(1, numPorts, -1); // Sailing used to reach each port
+        StampedArray<bool> &forwardVisited = workspace.flags(0, numPorts);
+        StampedArray<int> &forwardArrivalStamps = workspace.ints(2, numPorts, -1); // Arrival timestamp at each port
 
-        // Backward search from destination
-        int *backwardDist = new int[numPorts];
-        int *backwardParent = new int[numPorts];
-        bool *backwardVisited = new bool[numPorts];
+        // Backward search from destination (plain sailing costs)
+        StampedArray<int> &backwardDist = workspace.ints(3, numPorts, numeric_limits<int>::max());
+        StampedArray<bool> &backwardSettled = workspace.flags(1, numPorts);
 
-        for (int i = 0; i < numPorts; i++)
+        const LandmarkIndex &landmarks = graph->getLandmarks();
+        IndexedMinHeap<int> &forwardFrontier = workspace.frontier(0, numPorts);
+        IndexedMinHeap<int> &backwardFrontier = workspace.frontier(1, numPorts);
+
+        int originBound = landmarks.lowerBound(originIdx, destIdx);
+        if (originBound != LandmarkIndex::UNREACHABLE)
         {
-            forwardDist[i] = numeric_limits<int>::max();
-            forwardParent[i] = -1;
-            forwardVisited[i] = false;
-            forwardArrivalDates[i] = "";
-            forwardArrivalTimes[i] = "";
-            backwardDist[i] = numeric_limits<int>::max();
-            backwardParent[i] = -1;
-            backwardVisited[i] = false;
+            forwardDist[originIdx] = 0;
+            forwardArrivalStamps[originIdx] = Route::toTimestamp(date, "00:00"); // Start at beginning of day
+            forwardFrontier.pushOrDecrease(originIdx, originBound);
+            backwardDist[destIdx] = 0;
+            backwardFrontier.pushOrDecrease(destIdx, originBound);
         }
 
-        forwardDist[originIdx] = 0;
-        forwardArrivalDates[originIdx] = date;
-        forwardArrivalTimes[originIdx] = "00:00";
-        backwardDist[destIdx] = 0;
-
-        int meetingPoint = -1;
-        int bestDistance = numeric_limits<int>::max();
+        int bestDistance = numeric_limits<int>::max(); // mu: cheapest voyage found so far
+        bool backwardDone = false;                       // Unsettled ports can no longer beat mu
 
-        cout << "Running bidirectional Dijkstra..." << endl;
+        cout << "Running bidirectional ALT search with " << landmarks.getLandmarkCount() << " landmarks..." << endl;
 
         // Alternate between forward and backward search
-        for (int iteration = 0; iteration < numPorts * 2; iteration++)
+        int forwardMinIdx, forwardKey;
+        while (forwardFrontier.extractMin(forwardMinIdx, forwardKey))
         {
-            // Forward search step
-            int forwardMinDist = numeric_limits<int>::max();
-            int forwardMinIdx = -1;
-            for (int i = 0; i < numPorts; i++)
+            // Backward search step
+            if (!backwardDone)
             {
-                if (!forwardVisited[i] && forwardDist[i] < forwardMinDist)
+                int backwardMinIdx, backwardKey;
+                if (!backwardFrontier.extractMin(backwardMinIdx, backwardKey) || backwardKey >= bestDistance)
                 {
-                    forwardMinDist = forwardDist[i];
-                    forwardMinIdx = i;
+                    backwardDone = true;
                 }
-            }
-
-            if (forwardMinIdx != -1)
-            {
-                forwardVisited[forwardMinIdx] = true;
-                string currentPort = portMapper.getName(forwardMinIdx);
-                string currentArrivalDate = forwardArrivalDates[forwardMinIdx];
-                string currentArrivalTime = forwardArrivalTimes[forwardMinIdx];
-
-                // Get connecting routes with proper time tracking
-                LinkedList<Route> routes = graph->getConnectingRoutes(currentPort, currentArrivalDate, currentArrivalTime);
-
-                for (int i = 0; i < routes.getSize(); i++)
+                else
                 {
-                    const Route &route = routes.get(i);
-                    int neighborIdx = portMapper.findIndex(route.destination);
-                    if (neighborIdx == -1 || forwardVisited[neighborIdx])
-                        continue;
-
-                    // Calculate layover hours and port charge
-                    int layoverHours = 0;
-                    int portCharge = 0;
-
-                    if (forwardParent[forwardMinIdx] != -1)
-                    {
-                        // Find previous route to calculate layover
-                        string fromPort = portMapper.getName(forwardParent[forwardMinIdx]);
-                        string toPort = currentPort;
-                        string prevArrivalDate = forwardArrivalDates[forwardMinIdx];
-                        string prevArrivalTime = forwardArrivalTimes[forwardMinIdx];
-
-                        LinkedList<Route> prevRoutes = graph->getConnectingRoutes(fromPort, forwardArrivalDates[forwardParent[forwardMinIdx]], forwardArrivalTimes[forwardParent[forwardMinIdx]]);
-                        for (int j = 0; j < prevRoutes.getSize(); j++)
-                        {
-                            if (prevRoutes.get(j).destination == toPort && prevRoutes.get(j).date == prevArrivalDate)
-                            {
-                                const Route &previousRoute = prevRoutes.get(j);
-                                layoverHours = Route::calculateLayoverHours(previousRoute, route);
-
-                                // Calculate port charge if layover > 12 hours
-                                if (layoverHours > 12)
-                                {
-                                    Port portInfo;
-                                    if (graph->getPort(currentPort, portInfo))
-                                    {
-                                        int days = (layoverHours + 11) / 24;
-                                        if (days == 0)
-                                            days = 1;
-                                        portCharge = portInfo.dailyCharge * days;
-                                    }
-                                }
-                                break;
-                            }
-                        }
-                    }
+                    backwardSettled[backwardMinIdx] = true;
 
-                    // Calculate total cost including port charges
-                    int newDist = forwardDist[forwardMinIdx] + route.cost + portCharge;
-                    if (newDist < forwardDist[neighborIdx])
+                    // Sailings INTO this port, from the reverse adjacency
+                    for (int i = graph->getInEdgeBegin(backwardMinIdx); i < graph->getInEdgeEnd(backwardMinIdx); i++)
                     {
-                        forwardDist[neighborIdx] = newDist;
-                        forwardParent[neighborIdx] = forwardMinIdx;
-                        forwardArrivalDates[neighborIdx] = route.date;
-                        forwardArrivalTimes[neighborIdx] = route.arrivalTime;
-                    }
-
-                    // Check if this node was visited by backward search
-                    if (backwardVisited[neighborIdx])
-                    {
-                        int totalDist = forwardDist[neighborIdx] + backwardDist[neighborIdx];
-                        if (totalDist < bestDistance)
+                        const Graph::Edge &edge = graph->getEdge(graph->getInEdge(i));
+                        int fromIdx = graph->getRouteOriginId(edge.routeIndex);
+                        if (backwardSettled[fromIdx])
+                            continue;
+
+                        int newDist = backwardDist[backwardMinIdx] + edge.cost;
+                        int bound = landmarks.lowerBound(originIdx, fromIdx);
+                        if (newDist < backwardDist[fromIdx] && bound != LandmarkIndex::UNREACHABLE)
                         {
-                            bestDistance = totalDist;
-                            meetingPoint = neighborIdx;
+                            backwardDist[fromIdx] = newDist;
+                            backwardFrontier.pushOrDecrease(fromIdx, newDist + bound);
                         }
                     }
                 }
             }
 
-            // Backward search step
-            int backwardMinDist = numeric_limits<int>::max();
-            int backwardMinIdx = -1;
-            for (int i = 0; i < numPorts; i++)
+            // Forward search step
+            forwardVisited[forwardMinIdx] = true;
+            if (forwardMinIdx == destIdx)
             {
-                if (!backwardVisited[i] && backwardDist[i] < backwardMinDist)
-                {
-                    backwardMinDist = backwardDist[i];
-                    backwardMinIdx = i;
-                }
+                break;
             }
+            if (backwardDone && !backwardSettled[forwardMinIdx])
+            {
+                continue; // Every voyage through here costs at least mu
+            }
+
+            int currentArrivalStamp = forwardArrivalStamps[forwardMinIdx];
+            const Port &currentPortInfo = graph->getPortById(forwardMinIdx);
 
-            if (backwardMinIdx != -1)
+            Graph::EdgeRange routes = graph->getDeparturesAfter(forwardMinIdx, currentArrivalStamp);
+            for (const Graph::Edge *edge = routes.begin(); edge != routes.end(); edge++)
             {
-                backwardVisited[backwardMinIdx] = true;
-                string currentPort = portMapper.getName(backwardMinIdx);
+                int neighborIdx = edge->destination;
+                if (neighborIdx == -1 || forwardVisited[neighborIdx])
+                    continue;
+                if (backwardDone && !backwardSettled[neighborIdx])
+                    continue;
 
-                // Find routes TO this port (reverse direction) - include all dates
-                for (int i = 0; i < allPorts.getSize(); i++)
+                // Port charge only for layovers > 12 hours (none at the origin)
+                int portCharge = 0;
+                if (forwardParentEdge[forwardMinIdx] != -1)
                 {
-                    string potentialPort = allPorts.get(i).name;
-                    LinkedList<Route> routes = graph->getRoutesFrom(potentialPort);
-
-                    for (int j = 0; j < routes.getSize(); j++)
+                    int layoverHours = (edge->departure - currentArrivalStamp) / 60;
+                    if (layoverHours > 12)
                     {
-                        const Route &route = routes.get(j);
-                        if (route.destination == currentPort)
-                        {
-                            int fromIdx = portMapper.findIndex(potentialPort);
-                            if (fromIdx == -1 || backwardVisited[fromIdx])
-                                continue;
-
-                            // Don't apply port charges during search - will calculate properly after path reconstruction
-                            // Port charges should only apply for layovers > 12 hours, which requires knowing the full path
-                            int newDist = backwardDist[backwardMinIdx] + route.cost;
-                            if (newDist < backwardDist[fromIdx])
-                            {
-                                backwardDist[fromIdx] = newDist;
-                                backwardParent[fromIdx] = backwardMinIdx;
-                            }
-
-                            // Check if this node was visited by forward search
-                            if (forwardVisited[fromIdx])
-                            {
-                                int totalDist = forwardDist[fromIdx] + backwardDist[fromIdx];
-                                if (totalDist < bestDistance)
-                                {
-                                    bestDistance = totalDist;
-                                    meetingPoint = fromIdx;
-                                }
-                            }
-                        }
+                        int days = (layoverHours + 11) / 24;
+                        if (days == 0)
+                            days = 1;
+                        portCharge = currentPortInfo.dailyCharge * days;
                     }
                 }
-            }
-
-            // Stop if we found a meeting point
-            if (meetingPoint != -1 && bestDistance < numeric_limits<int>::max())
-            {
-                break;
-            }
 
-            // Stop if both searches exhausted
-            if (forwardMinIdx == -1 && backwardMinIdx == -1)
-            {
-                break;
+                int newDist = forwardDist[forwardMinIdx] + edge->cost + portCharge;
+                int bound = landmarks.lowerBound(neighborIdx, destIdx);
+                if (newDist < forwardDist[neighborIdx] && bound != LandmarkIndex::UNREACHABLE)
+                {
+                    forwardDist[neighborIdx] = newDist;
+                    forwardParentEdge[neighborIdx] = graph->getEdgeIndex(edge);
+                    forwardArrivalStamps[neighborIdx] = edge->arrival;
+                    forwardFrontier.pushOrDecrease(neighborIdx, newDist + bound);
+                    if (neighborIdx == destIdx && newDist < bestDistance)
+                    {
+                        bestDistance = newDist;
+                    }
+                }
             }
         }
 
         // Reconstruct path if found
-        if (meetingPoint != -1)
+        if (forwardVisited[destIdx])
         {
             result.found = true;
-            result.totalCost = bestDistance;
 
-            // Reconstruct forward path
-            LinkedList<int> forwardPath;
-            int current = meetingPoint;
-            while (current != -1)
-            {
-                forwardPath.push_back(current);
-                current = forwardParent[current];
-            }
-
-            // Reconstruct backward path (excluding meeting point)
-            LinkedList<int> backwardPath;
-            current = backwardParent[meetingPoint];
-            while (current != -1)
-            {
-                backwardPath.push_back(current);
-                current = backwardParent[current];
-            }
-
-            // Combine paths
-            for (int i = forwardPath.getSize() - 1; i >= 0; i--)
-            {
-                result.path.push_back(portMapper.getName(forwardPath.get(i)));
-            }
-            for (int i = 0; i < backwardPath.getSize(); i++)
+            // Read the sailings back through the forward parents
+            ArrayList<int> sailings;
+            for (int current = destIdx; forwardParentEdge[current] != -1;
+                 current = graph->getRouteOriginId(graph->getEdge(forwardParentEdge[current]).routeIndex))
             {
-                result.path.push_back(portMapper.getName(backwardPath.get(i)));
+                sailings.push_back(graph->getEdge(forwardParentEdge[current]).routeIndex);
             }
+            sailings.reverse();
 
-            // Get routes for the path - support multi-day waiting
-            if (result.path.getSize() >= 2)
+            result.path.push_back(origin);
+            for (int i = 0; i < sailings.getSize(); i++)
             {
-                for (int i = 0; i < result.path.getSize() - 1; i++)
-                {
-                    string from = result.path.get(i);
-                    string to = result.path.get(i + 1);
-
-                    // For first leg, use input date
-                    // For subsequent legs, use arrival date from previous route
-                    string departureDate = (i == 0) ? date : result.routes.get(i - 1).date;
-                    string departureTime = (i == 0) ? "00:00" : result.routes.get(i - 1).arrivalTime;
-
-                    LinkedList<Route> connectingRoutes = graph->getConnectingRoutes(from, departureDate, departureTime);
-                    for (int j = 0; j < connectingRoutes.getSize(); j++)
-                    {
-                        if (connectingRoutes.get(j).destination == to)
-                        {
-                            result.routes.push_back(connectingRoutes.get(j));
-                            break;
-                        }
-                    }
-                }
+                const Route &route = graph->getRouteByIndex(sailings.get(i));
+                result.routes.push_back(route);
+                result.path.push_back(route.destination);
             }
 
             // Recalculate total cost properly with layover-based port charges
@@ -1684,7 +1294,7 @@ public:
                 }
 
                 LayoverInfo layover(layoverPort, layoverHours, portCharge,
-                                    arrivingRoute.date, arrivingRoute.arrivalTime,
+                                    Route::dateFromTimestamp(arrivingRoute.arrivalStamp), arrivingRoute.arrivalTime,
                                     departingRoute.date, departingRoute.departureTime);
                 result.layovers.push_back(layover);
             }
@@ -1738,19 +1348,9 @@ public:
             }
             cout << "  Total Cost: $" << result.totalCost << endl;
 
-            // Calculate total travel time (route times + layover times)
-            int totalTravelHours = 0;
-            for (int i = 0; i < result.routes.getSize(); i++)
-            {
-                const Route &route = result.routes.get(i);
-                // Each route takes approximately 24 hours (1 day travel)
-                totalTravelHours += 24;
-            }
-            // Add layover hours
-            for (int i = 0; i < result.layovers.getSize(); i++)
-            {
-                totalTravelHours += result.layovers.get(i).layoverHours;
-            }
+            // Total travel time: first departure to final arrival (sailing + layovers)
+            int totalTravelHours = (result.routes.get(result.routes.getSize() - 1).arrivalStamp -
+                                    result.routes.get(0).departureStamp) / 60;
             result.totalTravelTime = totalTravelHours;
             cout << "  Total Travel Time: " << totalTravelHours << " hours ("
                  << (totalTravelHours / 24) << " days " << (totalTravelHours % 24) << " hours)" << endl;
@@ -1760,15 +1360,6 @@ public:
             cout << "No path found using bidirectional search!" << endl;
         }
 
-        delete[] forwardDist;
-        delete[] forwardParent;
-        delete[] forwardVisited;
-        delete[] forwardArrivalDates;
-        delete[] forwardArrivalTimes;
-        delete[] backwardDist;
-        delete[] backwardParent;
-        delete[] backwardVisited;
-
         return result;
     }
 };
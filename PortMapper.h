@@ -3,13 +3,14 @@
 #ifndef PORTMAPPER_H
 #define PORTMAPPER_H
 #include <string>
-#include "LinkedList.h"
+#include "ArrayList.h"
+#include "SymbolTable.h"
 using namespace std;
 // Simple port mapper that doesn't use HashTable with strings
 class PortMapper
 {
 private:
-    LinkedList<string> portNames;
+    ArrayList<Symbol> portNames;
 
 public:
     PortMapper() {}
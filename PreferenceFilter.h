@@ -4,15 +4,16 @@
 #define PREFERENCEFILTER_H
 
 #include "LinkedList.h"
+#include "ArrayList.h"
 #include "Route.h"
 #include <string>
 using namespace std;
 // Structure to hold user preferences for route booking
 struct PreferenceFilter
 {
-    LinkedList<string> preferredCompanies; // Shipping companies to prefer
-    LinkedList<string> requiredPorts;      // Ports that must be included in path
-    LinkedList<string> excludedPorts;      // Ports to avoid
+    LinkedList<Symbol> preferredCompanies; // Shipping companies to prefer
+    LinkedList<Symbol> requiredPorts;      // Ports that must be included in path
+    LinkedList<Symbol> excludedPorts;      // Ports to avoid
     int maxVoyageTime;                     // Maximum total voyage time in hours (-1 if no limit)
     bool hasCompanyPreference;
     bool hasPortPreference;
@@ -62,7 +63,7 @@ struct PreferenceFilter
     }
 
     // Check if a path (list of ports) includes all required ports
-    bool pathMatchesPorts(const LinkedList<string> &path) const
+    bool pathMatchesPorts(const ArrayList<Symbol> &path) const
     {
         if (!hasPortPreference || requiredPorts.getSize() == 0)
         {
@@ -90,33 +91,20 @@ struct PreferenceFilter
     }
 
     // Calculate total voyage time for a path (in hours)
-    // This is a simplified calculation - you may need to enhance it
-    int calculateVoyageTime(const LinkedList<Route> &routes) const
+    // From the first departure to the last arrival, including layovers
+    int calculateVoyageTime(const ArrayList<Route> &routes) const
     {
         if (routes.getSize() == 0)
             return 0;
 
-        // For simplicity, calculate time difference between first departure and last arrival
-        // In a real system, you'd parse dates and times properly
         const Route &firstRoute = routes.get(0);
         const Route &lastRoute = routes.get(routes.getSize() - 1);
 
-        // Parse times (HH:MM format)
-        int firstHour = (firstRoute.departureTime[0] - '0') * 10 + (firstRoute.departureTime[1] - '0');
-        int firstMin = (firstRoute.departureTime[3] - '0') * 10 + (firstRoute.departureTime[4] - '0');
-        int lastHour = (lastRoute.arrivalTime[0] - '0') * 10 + (lastRoute.arrivalTime[1] - '0');
-        int lastMin = (lastRoute.arrivalTime[3] - '0') * 10 + (lastRoute.arrivalTime[4] - '0');
-
-        // Simple calculation (assumes same day for now)
-        int totalMinutes = (lastHour * 60 + lastMin) - (firstHour * 60 + firstMin);
-        if (totalMinutes < 0)
-            totalMinutes += 24 * 60; // Wrap around if needed
-
-        return totalMinutes / 60; // Return hours
+        return (lastRoute.arrivalStamp - firstRoute.departureStamp) / 60; // Return hours
     }
 
     // Check if voyage time is within limit
-    bool isVoyageTimeValid(const LinkedList<Route> &routes) const
+    bool isVoyageTimeValid(const ArrayList<Route> &routes) const
     {
         if (!hasTimeLimit || maxVoyageTime < 0)
         {
@@ -504,7 +504,7 @@ private:
     }
 
     void renderSummaryItem(sf::RenderWindow &window, sf::Font &font, float x, float y,
-                           const string &label, bool hasValue, const LinkedList<string> &values,
+                           const string &label, bool hasValue, const LinkedList<Symbol> &values,
                            const string &defaultValue, sf::Color valueColor)
     {
 
@@ -0,0 +1,124 @@
+#pragma once
+#ifndef PREFERENCEMASK_H
+#define PREFERENCEMASK_H
+
+#include "Graph.h"
+#include "PreferenceFilter.h"
+#include "ArrayList.h"
+using namespace std;
+// A PreferenceFilter compiled against one graph for the length of a query.
+// Preferred companies and excluded ports become bitsets over the graph's
+// interned company and port IDs, so checking a sailing is a shift and an
+// AND per criterion instead of string compares against each list entry.
+// Same answer as PreferenceFilter::matchesRoute for every sailing between
+// known ports. Keep one around and recompile it per query to reuse the
+// storage.
+class PreferenceMask
+{
+private:
+    typedef unsigned long long Word;
+    static const int WORD_BITS = 64;
+
+    ArrayList<Word> allowedCompanies; // Empty when any company is fine
+    ArrayList<Word> excludedPorts;    // Empty when no port is excluded
+    bool filterCompanies;
+    bool filterPorts;
+
+    static void resetBits(ArrayList<Word> &bits, int count)
+    {
+        int words = (count + WORD_BITS - 1) / WORD_BITS;
+        bits.clear();
+        bits.reserve(words);
+        for (int w = 0; w < words; w++)
+        {
+            bits.push_back(0);
+        }
+    }
+
+    static bool testBit(const ArrayList<Word> &bits, int index)
+    {
+        return (bits[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+    }
+
+    static void setBit(ArrayList<Word> &bits, int index)
+    {
+        bits[index / WORD_BITS] |= Word(1) << (index % WORD_BITS);
+    }
+
+public:
+    PreferenceMask() : filterCompanies(false), filterPorts(false) {}
+
+    void compile(const PreferenceFilter &preferences, const Graph &graph)
+    {
+        filterCompanies = preferences.hasCompanyPreference && preferences.preferredCompanies.getSize() > 0;
+        filterPorts = preferences.hasPortPreference && preferences.excludedPorts.getSize() > 0;
+
+        if (filterCompanies)
+        {
+            // Names the graph has never seen match no sailing, as before
+            resetBits(allowedCompanies, graph.getCompanyCount());
+            for (int i = 0; i < preferences.preferredCompanies.getSize(); i++)
+            {
+                int companyId = graph.getCompanyId(preferences.preferredCompanies.get(i));
+                if (companyId != -1)
+                {
+                    setBit(allowedCompanies, companyId);
+                }
+            }
+        }
+        if (filterPorts)
+        {
+            resetBits(excludedPorts, graph.getVertexCount());
+            for (int i = 0; i < preferences.excludedPorts.getSize(); i++)
+            {
+                int portId = graph.getPortId(preferences.excludedPorts.get(i));
+                if (portId != -1)
+                {
+                    setBit(excludedPorts, portId);
+                }
+            }
+        }
+    }
+
+    bool allowsCompany(int company) const
+    {
+        return !filterCompanies || testBit(allowedCompanies, company);
+    }
+
+    bool isExcluded(int port) const
+    {
+        return filterPorts && port != -1 && testBit(excludedPorts, port);
+    }
+
+    // Whether the sailing edge out of originPort satisfies the preferences
+    bool allows(int originPort, const Graph::Edge &edge) const
+    {
+        return allowsCompany(edge.company) && !isExcluded(originPort) && !isExcluded(edge.destination);
+    }
+
+    // Same sets as plain bool arrays (nullptr when unfiltered), in the form
+    // ReachabilityIndex::findPortsReaching takes them
+    const bool *fillAllowedCompanies(bool *companies, int companyCount) const
+    {
+        if (!filterCompanies)
+            return nullptr;
+        for (int c = 0; c < companyCount; c++)
+        {
+            companies[c] = testBit(allowedCompanies, c);
+        }
+        return companies;
+    }
+
+    const bool *fillExcludedPorts(bool *ports, int portCount) const
+    {
+        if (!filterPorts)
+            return nullptr;
+        for (int p = 0; p < portCount; p++)
+        {
+            ports[p] = testBit(excludedPorts, p);
+        }
+        return ports;
+    }
+};
+
+#endif
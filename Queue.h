@@ -2,6 +2,7 @@
 #pragma once
 #ifndef QUEUE_H
 #define QUEUE_H
+#include "NodePool.h"
 template <typename T>
 class Queue
 {
@@ -12,6 +13,7 @@ private:
         Node *next;
         Node(const T &value) : data(value), next(nullptr) {}
     };
+    NodePool<Node> pool; // Nodes are recycled instead of going back to the heap
     Node *front;
     Node *rear;
     int size;
@@ -24,7 +26,7 @@ public:
     }
     void enqueue(const T &value)
     {
-        Node *newNode = new Node(value);
+        Node *newNode = pool.create(value);
         if (!rear)
         {
             front = rear = newNode;
@@ -44,7 +46,7 @@ public:
         front = front->next;
         if (!front)
             rear = nullptr;
-        delete temp;
+        pool.destroy(temp);
         size--;
         return true;
     }
@@ -70,10 +72,31 @@ public:
         {
             Node *temp = front;
             front = front->next;
-            delete temp;
+            pool.destroy(temp);
         }
         rear = nullptr;
         size = 0;
     }
+    // Read-only iteration front to back, without dequeuing
+    class ConstIterator
+    {
+    private:
+        const Node *current;
+
+    public:
+        ConstIterator(const Node *node) : current(node) {}
+        const T &operator*() const { return current->data; }
+        ConstIterator &operator++()
+        {
+            current = current->next;
+            return *this;
+        }
+        bool operator!=(const ConstIterator &other) const
+        {
+            return current != other.current;
+        }
+    };
+    ConstIterator begin() const { return ConstIterator(front); }
+    ConstIterator end() const { return ConstIterator(nullptr); }
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,494 @@
+#pragma once
+#ifndef REACHABILITY_INDEX_H
+#define REACHABILITY_INDEX_H
+
+#include "IndexedMinHeap.h"
+#include <limits>
+#include <ostream>
+#include <cstring>
+using namespace std;
+// Static (timetable-free) facts about the route network, built from the
+// graph's adjacency on first use:
+//
+//  - for every port and shipping company, a bitset of the ports with a
+//    sailing of that company into the port, so "which ports can still
+//    reach the destination using these companies" is a reverse BFS done
+//    a word (64 ports) at a time;
+//  - for every pair of ports, the cheapest possible sum of sailing costs,
+//    the shortest possible time at sea and the fewest possible legs.
+//    Waiting for departures and port charges only add to a real voyage,
+//    so all three are admissible (and consistent) A* heuristics.
+//
+// The tables only depend on the cheapest and the fastest sailing of each
+// ordered pair of ports, so the searches run over those lanes rather than
+// over every sailing of the timetable.
+class ReachabilityIndex
+{
+public:
+    static const int UNREACHABLE = numeric_limits<int>::max();
+
+private:
+    typedef unsigned long long Word;
+    static const int WORD_BITS = 64;
+
+    int portCount;
+    int companyCount;
+    int wordsPerSet;
+    Word *predecessors; // Set of row (port * companyCount + company)
+    int *minCost;       // from * portCount + to
+    int *minDuration;   // from * portCount + to, in minutes
+    int *minLegs;       // from * portCount + to
+
+    Word *predecessorSet(int port, int company) const
+    {
+        return predecessors + (static_cast<long long>(port) * companyCount + company) * wordsPerSet;
+    }
+
+    // Fill column target of table with shortest weighted distances to target
+    // (lanes into port p are inLanes[inOffsets[p] .. inOffsets[p + 1]))
+    void backwardDijkstra(int target, const int *weights, const int *laneOrigin,
+                          const int *inOffsets, const int *inLanes,
+                          int *distance, IndexedMinHeap<int> &frontier, int *table)
+    {
+        for (int p = 0; p < portCount; p++)
+        {
+            distance[p] = UNREACHABLE;
+        }
+        distance[target] = 0;
+        frontier.pushOrDecrease(target, 0);
+
+        int port, portDistance;
+        while (frontier.extractMin(port, portDistance))
+        {
+            table[static_cast<long long>(port) * portCount + target] = portDistance;
+            for (int i = inOffsets[port]; i < inOffsets[port + 1]; i++)
+            {
+                int lane = inLanes[i];
+                int from = laneOrigin[lane];
+                if (portDistance + weights[lane] < distance[from])
+                {
+                    distance[from] = portDistance + weights[lane];
+                    frontier.pushOrDecrease(from, distance[from]);
+                }
+            }
+        }
+    }
+
+    // Lower table through a new arc from -> to of the given weight. Row to
+    // and column from cannot change (weights are not negative), so the
+    // update can run in place.
+    void relaxThrough(int *table, int from, int to, int weight)
+    {
+        if (table[static_cast<long long>(from) * portCount + to] <= weight)
+        {
+            return;
+        }
+        const int *toRow = table + static_cast<long long>(to) * portCount;
+        for (int x = 0; x < portCount; x++)
+        {
+            int *row = table + static_cast<long long>(x) * portCount;
+            if (row[from] == UNREACHABLE)
+            {
+                continue;
+            }
+            int viaArc = row[from] + weight;
+            for (int y = 0; y < portCount; y++)
+            {
+                if (toRow[y] != UNREACHABLE && viaArc + toRow[y] < row[y])
+                {
+                    row[y] = viaArc + toRow[y];
+                }
+            }
+        }
+    }
+
+    void release()
+    {
+        delete[] predecessors;
+        delete[] minCost;
+        delete[] minDuration;
+        delete[] minLegs;
+        predecessors = nullptr;
+        minCost = nullptr;
+        minDuration = nullptr;
+        minLegs = nullptr;
+    }
+
+public:
+    ReachabilityIndex() : portCount(0), companyCount(0), wordsPerSet(0),
+                          predecessors(nullptr), minCost(nullptr), minDuration(nullptr), minLegs(nullptr) {}
+
+    ~ReachabilityIndex()
+    {
+        release();
+    }
+
+    ReachabilityIndex(const ReachabilityIndex &) = delete;
+    ReachabilityIndex &operator=(const ReachabilityIndex &) = delete;
+
+    // Build from a CSR adjacency (edges of port p are
+    // edges[edgeOffsets[p] .. edgeOffsets[p + 1])). Edges need destination
+    // (-1 if unknown), cost, departure, arrival and company fields.
+    template <typename EdgeT>
+    void build(int ports, int companies, const int *edgeOffsets, const EdgeT *edges)
+    {
+        release();
+        portCount = ports;
+        companyCount = companies > 0 ? companies : 1;
+        wordsPerSet = (portCount + WORD_BITS - 1) / WORD_BITS;
+        if (wordsPerSet == 0)
+        {
+            wordsPerSet = 1;
+        }
+
+        long long setWords = static_cast<long long>(portCount) * companyCount * wordsPerSet;
+        predecessors = new Word[setWords > 0 ? setWords : 1];
+        for (long long i = 0; i < setWords; i++)
+        {
+            predecessors[i] = 0;
+        }
+
+        // One lane per ordered pair with sailings, keeping the lowest cost
+        // and the shortest time at sea (not necessarily the same sailing)
+        int slots = portCount > 0 ? portCount : 1;
+        int numEdges = edgeOffsets[portCount];
+        int *laneOrigin = new int[numEdges > 0 ? numEdges : 1];
+        int *laneDestination = new int[numEdges > 0 ? numEdges : 1];
+        int *costWeights = new int[numEdges > 0 ? numEdges : 1];
+        int *durationWeights = new int[numEdges > 0 ? numEdges : 1];
+        int *laneTo = new int[slots]; // Latest lane into each port while scanning
+        for (int p = 0; p < portCount; p++)
+        {
+            laneTo[p] = -1;
+        }
+        int laneCount = 0;
+        for (int p = 0; p < portCount; p++)
+        {
+            for (int e = edgeOffsets[p]; e < edgeOffsets[p + 1]; e++)
+            {
+                int to = edges[e].destination;
+                if (to == -1)
+                    continue;
+                predecessorSet(to, edges[e].company)[p / WORD_BITS] |= Word(1) << (p % WORD_BITS);
+
+                int duration = edges[e].arrival - edges[e].departure;
+                int lane = laneTo[to];
+                if (lane == -1 || laneOrigin[lane] != p)
+                {
+                    lane = laneCount++;
+                    laneTo[to] = lane;
+                    laneOrigin[lane] = p;
+                    laneDestination[lane] = to;
+                    costWeights[lane] = edges[e].cost;
+                    durationWeights[lane] = duration;
+                    continue;
+                }
+                if (edges[e].cost < costWeights[lane])
+                    costWeights[lane] = edges[e].cost;
+                if (duration < durationWeights[lane])
+                    durationWeights[lane] = duration;
+            }
+        }
+
+        // Lanes by destination (counting sort), for the backward searches
+        int *inOffsets = new int[portCount + 1];
+        int *inLanes = new int[laneCount > 0 ? laneCount : 1];
+        for (int p = 0; p <= portCount; p++)
+        {
+            inOffsets[p] = 0;
+        }
+        for (int lane = 0; lane < laneCount; lane++)
+        {
+            inOffsets[laneDestination[lane] + 1]++;
+        }
+        for (int p = 0; p < portCount; p++)
+        {
+            inOffsets[p + 1] += inOffsets[p];
+            laneTo[p] = inOffsets[p];
+        }
+        for (int lane = 0; lane < laneCount; lane++)
+        {
+            inLanes[laneTo[laneDestination[lane]]++] = lane;
+        }
+
+        long long cells = static_cast<long long>(portCount) * portCount;
+        minCost = new int[cells > 0 ? cells : 1];
+        minDuration = new int[cells > 0 ? cells : 1];
+        minLegs = new int[cells > 0 ? cells : 1];
+        for (long long i = 0; i < cells; i++)
+        {
+            minCost[i] = UNREACHABLE;
+            minDuration[i] = UNREACHABLE;
+            minLegs[i] = UNREACHABLE;
+        }
+
+        // Backward Dijkstras (costs, durations) and a BFS (legs) per target port
+        int *distance = new int[slots];
+        int *queue = new int[slots];
+        IndexedMinHeap<int> frontier(portCount);
+        for (int target = 0; target < portCount; target++)
+        {
+            backwardDijkstra(target, costWeights, laneOrigin, inOffsets, inLanes, distance, frontier, minCost);
+            backwardDijkstra(target, durationWeights, laneOrigin, inOffsets, inLanes, distance, frontier, minDuration);
+
+            int head = 0, tail = 0;
+            queue[tail++] = target;
+            minLegs[static_cast<long long>(target) * portCount + target] = 0;
+            while (head < tail)
+            {
+                int current = queue[head++];
+                int legs = minLegs[static_cast<long long>(current) * portCount + target];
+                for (int i = inOffsets[current]; i < inOffsets[current + 1]; i++)
+                {
+                    int from = laneOrigin[inLanes[i]];
+                    int &fromLegs = minLegs[static_cast<long long>(from) * portCount + target];
+                    if (fromLegs == UNREACHABLE)
+                    {
+                        fromLegs = legs + 1;
+                        queue[tail++] = from;
+                    }
+                }
+            }
+        }
+
+        delete[] distance;
+        delete[] queue;
+        delete[] inOffsets;
+        delete[] inLanes;
+        delete[] laneTo;
+        delete[] costWeights;
+        delete[] durationWeights;
+        delete[] laneOrigin;
+        delete[] laneDestination;
+    }
+
+    // Bytes write() produces for a network of this size: the predecessor
+    // sets, then the cost, duration and legs tables
+    static size_t imageSize(int ports, int companies)
+    {
+        long long words = (ports + WORD_BITS - 1) / WORD_BITS;
+        long long sets = static_cast<long long>(ports) * (companies > 0 ? companies : 1) * (words > 0 ? words : 1);
+        long long cells = static_cast<long long>(ports) * ports;
+        return static_cast<size_t>(sets * sizeof(Word) + 3 * cells * sizeof(int));
+    }
+
+    // Raw tables for a snapshot (see ScheduleSnapshot)
+    void write(ostream &out) const
+    {
+        long long sets = static_cast<long long>(portCount) * companyCount * wordsPerSet;
+        long long cells = static_cast<long long>(portCount) * portCount;
+        out.write(reinterpret_cast<const char *>(predecessors), sets * sizeof(Word));
+        out.write(reinterpret_cast<const char *>(minCost), cells * sizeof(int));
+        out.write(reinterpret_cast<const char *>(minDuration), cells * sizeof(int));
+        out.write(reinterpret_cast<const char *>(minLegs), cells * sizeof(int));
+    }
+
+    // Take tables from an image write() made for this many ports and
+    // companies (imageSize(ports, companies) bytes, any alignment)
+    void restore(int ports, int companies, const char *image)
+    {
+        release();
+        portCount = ports;
+        companyCount = companies > 0 ? companies : 1;
+        wordsPerSet = (portCount + WORD_BITS - 1) / WORD_BITS;
+        if (wordsPerSet == 0)
+        {
+            wordsPerSet = 1;
+        }
+        long long sets = static_cast<long long>(portCount) * companyCount * wordsPerSet;
+        long long cells = static_cast<long long>(portCount) * portCount;
+        predecessors = new Word[sets > 0 ? sets : 1];
+        minCost = new int[cells > 0 ? cells : 1];
+        minDuration = new int[cells > 0 ? cells : 1];
+        minLegs = new int[cells > 0 ? cells : 1];
+        memcpy(predecessors, image, sets * sizeof(Word));
+        image += sets * sizeof(Word);
+        memcpy(minCost, image, cells * sizeof(int));
+        image += cells * sizeof(int);
+        memcpy(minDuration, image, cells * sizeof(int));
+        image += cells * sizeof(int);
+        memcpy(minLegs, image, cells * sizeof(int));
+    }
+
+    // Schedule changes without a rebuild. A new sailing from -> to sets its
+    // predecessor bit and lowers every pair through it,
+    //     d(x, y) = min(d(x, y), d(x, from) + w + d(to, y)),
+    // in O(ports^2) per table, or O(1) when the table already has from -> to
+    // no dearer than w (the tables always obey the triangle inequality, so
+    // then no pair can improve). A sailing that is cancelled or gets dearer
+    // needs no table change: the old values are still admissible and
+    // consistent bounds for the smaller network, only looser, until the
+    // next build(). Predecessor bits are kept exact by the caller through
+    // setPredecessor.
+    void addSailing(int from, int to, int company, int cost, int duration)
+    {
+        setPredecessor(to, company, from, true);
+        relaxThrough(minCost, from, to, cost);
+        relaxThrough(minDuration, from, to, duration);
+        relaxThrough(minLegs, from, to, 1);
+    }
+
+    // A sailing from -> to now costs less
+    void lowerCost(int from, int to, int cost)
+    {
+        relaxThrough(minCost, from, to, cost);
+    }
+
+    // Whether some sailing of company runs from -> port
+    void setPredecessor(int port, int company, int from, bool present)
+    {
+        Word bit = Word(1) << (from % WORD_BITS);
+        Word &word = predecessorSet(port, company)[from / WORD_BITS];
+        word = present ? (word | bit) : (word & ~bit);
+    }
+
+    // Make room for company IDs up to companies - 1 (a new company's sets
+    // start empty)
+    void ensureCompanies(int companies)
+    {
+        if (companies <= companyCount)
+        {
+            return;
+        }
+        long long setWords = static_cast<long long>(portCount) * companies * wordsPerSet;
+        Word *grown = new Word[setWords > 0 ? setWords : 1];
+        for (long long i = 0; i < setWords; i++)
+        {
+            grown[i] = 0;
+        }
+        for (int p = 0; p < portCount; p++)
+        {
+            for (int c = 0; c < companyCount; c++)
+            {
+                const Word *source = predecessorSet(p, c);
+                Word *target = grown + (static_cast<long long>(p) * companies + c) * wordsPerSet;
+                for (int w = 0; w < wordsPerSet; w++)
+                {
+                    target[w] = source[w];
+                }
+            }
+        }
+        delete[] predecessors;
+        predecessors = grown;
+        companyCount = companies;
+    }
+
+    bool canReach(int from, int to) const
+    {
+        return minLegs[static_cast<long long>(from) * portCount + to] != UNREACHABLE;
+    }
+
+    // Cheapest sum of sailing costs from -> to (UNREACHABLE if no path)
+    int getLowerBoundCost(int from, int to) const
+    {
+        return minCost[static_cast<long long>(from) * portCount + to];
+    }
+
+    // Shortest time at sea from -> to in minutes (UNREACHABLE if no path)
+    int getLowerBoundDuration(int from, int to) const
+    {
+        return minDuration[static_cast<long long>(from) * portCount + to];
+    }
+
+    // Fewest legs from -> to (UNREACHABLE if no path)
+    int getLowerBoundLegs(int from, int to) const
+    {
+        return minLegs[static_cast<long long>(from) * portCount + to];
+    }
+
+    // Mark reaches[p] for every port p that can reach target using only
+    // sailings of allowed companies (nullptr = any company) without
+    // touching an excluded port (nullptr = none). The target itself is
+    // always marked.
+    void findPortsReaching(int target, const bool *allowedCompanies, const bool *excludedPorts,
+                           bool *reaches) const
+    {
+        for (int p = 0; p < portCount; p++)
+        {
+            reaches[p] = false;
+        }
+        reaches[target] = true;
+        if (excludedPorts != nullptr && excludedPorts[target])
+        {
+            return; // Every sailing into the target touches an excluded port
+        }
+
+        if (allowedCompanies == nullptr && excludedPorts == nullptr)
+        {
+            for (int p = 0; p < portCount; p++)
+            {
+                reaches[p] = reaches[p] || canReach(p, target);
+            }
+            return;
+        }
+
+        Word *blocked = new Word[wordsPerSet];
+        Word *reached = new Word[wordsPerSet];
+        Word *frontier = new Word[wordsPerSet];
+        Word *next = new Word[wordsPerSet];
+        for (int w = 0; w < wordsPerSet; w++)
+        {
+            blocked[w] = 0;
+            reached[w] = 0;
+            frontier[w] = 0;
+        }
+        if (excludedPorts != nullptr)
+        {
+            for (int p = 0; p < portCount; p++)
+            {
+                if (excludedPorts[p])
+                    blocked[p / WORD_BITS] |= Word(1) << (p % WORD_BITS);
+            }
+        }
+        reached[target / WORD_BITS] |= Word(1) << (target % WORD_BITS);
+        frontier[target / WORD_BITS] = reached[target / WORD_BITS];
+
+        bool grew = true;
+        while (grew)
+        {
+            for (int w = 0; w < wordsPerSet; w++)
+            {
+                next[w] = 0;
+            }
+            for (int w = 0; w < wordsPerSet; w++)
+            {
+                Word bits = frontier[w];
+                for (int port = w * WORD_BITS; bits != 0; port++, bits >>= 1)
+                {
+                    if ((bits & 1) == 0)
+                        continue;
+                    for (int c = 0; c < companyCount; c++)
+                    {
+                        if (allowedCompanies != nullptr && !allowedCompanies[c])
+                            continue;
+                        const Word *row = predecessorSet(port, c);
+                        for (int k = 0; k < wordsPerSet; k++)
+                        {
+                            next[k] |= row[k];
+                        }
+                    }
+                }
+            }
+
+            grew = false;
+            for (int w = 0; w < wordsPerSet; w++)
+            {
+                frontier[w] = next[w] & ~reached[w] & ~blocked[w];
+                reached[w] |= frontier[w];
+                grew = grew || frontier[w] != 0;
+            }
+        }
+
+        for (int p = 0; p < portCount; p++)
+        {
+            reaches[p] = (reached[p / WORD_BITS] >> (p % WORD_BITS)) & 1;
+        }
+
+        delete[] blocked;
+        delete[] reached;
+        delete[] frontier;
+        delete[] next;
+    }
+};
+
+#endif
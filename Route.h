@@ -3,19 +3,25 @@
 #ifndef ROUTE_H
 #define ROUTE_H
 #include <string>
+#include "SymbolTable.h"
 using namespace std;
 class Route
 {
 public:
-    string origin;
-    string destination;
+    static const int MINUTES_PER_DAY = 24 * 60;
+
+    Symbol origin;        // Interned port name
+    Symbol destination;   // Interned port name
     string date;          // Format: DD/MM/YYYY
     string departureTime; // Format: HH:MM
     string arrivalTime;   // Format: HH:MM
     int cost;             // In USD
-    string shippingCompany;
-    Route() : origin(""), destination(""), date(""),
-              departureTime(""), arrivalTime(""), cost(0), shippingCompany("")
+    Symbol shippingCompany; // Interned company name
+    int departureStamp;   // Minutes since 01/01/1970 00:00, parsed once from date + departureTime
+    int arrivalStamp;     // Minutes since 01/01/1970 00:00 (next day if arrivalTime < departureTime)
+    Route() : origin(), destination(), date(""),
+              departureTime(""), arrivalTime(""), cost(0), shippingCompany(),
+              departureStamp(0), arrivalStamp(0)
     {
     }
     Route(const string &orig, const string &dest, const string &dt,
@@ -24,28 +30,86 @@ public:
         : origin(orig), destination(dest), date(dt), departureTime(depTime),
           arrivalTime(arrTime), cost(cst), shippingCompany(company)
     {
+        updateStamps();
+    }
+    // Recompute departureStamp/arrivalStamp after date or times were assigned
+    void updateStamps()
+    {
+        departureStamp = toTimestamp(date, departureTime);
+        arrivalStamp = toTimestamp(date, arrivalTime);
+        if (arrivalStamp < departureStamp)
+        {
+            arrivalStamp += MINUTES_PER_DAY; // Overnight voyage
+        }
     }
     // Helper function to compare times (returns true if time1 < time2)
     static bool isTimeBefore(const std::string &time1, const std::string &time2)
     {
-        int h1 = (time1[0] - '0') * 10 + (time1[1] - '0');
-        int m1 = (time1[3] - '0') * 10 + (time1[4] - '0');
-        int h2 = (time2[0] - '0') * 10 + (time2[1] - '0');
-        int m2 = (time2[3] - '0') * 10 + (time2[4] - '0');
-        if (h1 < h2)
-            return true;
-        if (h1 > h2)
-            return false;
-        return m1 < m2;
-    }
-    // Parse date string (DD/MM/YYYY) and return day, month, year
+        return parseClock(time1) < parseClock(time2);
+    }
+    // Parse date string (D/M/YYYY or DD/MM/YYYY) and return day, month, year
     static void parseDate(const std::string &dateStr, int &day, int &month, int &year)
     {
-        // Format: DD/MM/YYYY
-        day = (dateStr[0] - '0') * 10 + (dateStr[1] - '0');
-        month = (dateStr[3] - '0') * 10 + (dateStr[4] - '0');
-        year = (dateStr[6] - '0') * 1000 + (dateStr[7] - '0') * 100 +
-               (dateStr[8] - '0') * 10 + (dateStr[9] - '0');
+        size_t pos = 0;
+        day = readNumber(dateStr, pos);
+        month = readNumber(dateStr, pos);
+        year = readNumber(dateStr, pos);
+    }
+
+    // Minutes since midnight for a time string (HH:MM)
+    static int parseClock(const std::string &timeStr)
+    {
+        size_t pos = 0;
+        int hours = readNumber(timeStr, pos);
+        int minutes = readNumber(timeStr, pos);
+        return hours * 60 + minutes;
+    }
+
+    // Days since 01/01/1970 for a civil date (proleptic Gregorian, leap years included)
+    static int daysFromCivil(int day, int month, int year)
+    {
+        year -= month <= 2 ? 1 : 0;
+        int era = (year >= 0 ? year : year - 399) / 400;
+        int yearOfEra = year - era * 400;
+        int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    // Inverse of daysFromCivil
+    static void civilFromDays(int days, int &day, int &month, int &year)
+    {
+        days += 719468;
+        int era = (days >= 0 ? days : days - 146096) / 146097;
+        int dayOfEra = days - era * 146097;
+        int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        int mp = (5 * dayOfYear + 2) / 153;
+        day = dayOfYear - (153 * mp + 2) / 5 + 1;
+        month = mp < 10 ? mp + 3 : mp - 9;
+        year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+    }
+
+    // Days since 01/01/1970 for a date string
+    static int dayNumber(const std::string &dateStr)
+    {
+        int day, month, year;
+        parseDate(dateStr, day, month, year);
+        return daysFromCivil(day, month, year);
+    }
+
+    // Absolute timestamp (minutes since 01/01/1970 00:00) for a date and time
+    static int toTimestamp(const std::string &dateStr, const std::string &timeStr)
+    {
+        return dayNumber(dateStr) * MINUTES_PER_DAY + parseClock(timeStr);
+    }
+
+    // Date string (DD/MM/YYYY) of a timestamp
+    static std::string dateFromTimestamp(int stamp)
+    {
+        int day, month, year;
+        civilFromDays(stamp / MINUTES_PER_DAY, day, month, year);
+        return dateToString(day, month, year);
     }
 
     // Convert date to string (DD/MM/YYYY)
@@ -66,118 +130,58 @@ public:
     static std::string getNextDay(const std::string &dateStr)
     {
         int day, month, year;
-        parseDate(dateStr, day, month, year);
-
-        // Days in each month (assuming non-leap year for simplicity)
-        int daysInMonth[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-
-        day++;
-        if (day > daysInMonth[month - 1])
-        {
-            day = 1;
-            month++;
-            if (month > 12)
-            {
-                month = 1;
-                year++;
-            }
-        }
-
+        civilFromDays(dayNumber(dateStr) + 1, day, month, year);
         return dateToString(day, month, year);
     }
 
     // Calculate layover hours between two routes
     static int calculateLayoverHours(const Route &arrivingRoute, const Route &departingRoute)
     {
-        if (arrivingRoute.date == departingRoute.date)
+        int waitMinutes = departingRoute.departureStamp - arrivingRoute.arrivalStamp;
+        if (waitMinutes < 0)
         {
-            // Same day: calculate time difference
-            int arrHour = (arrivingRoute.arrivalTime[0] - '0') * 10 + (arrivingRoute.arrivalTime[1] - '0');
-            int arrMin = (arrivingRoute.arrivalTime[3] - '0') * 10 + (arrivingRoute.arrivalTime[4] - '0');
-            int depHour = (departingRoute.departureTime[0] - '0') * 10 + (departingRoute.departureTime[1] - '0');
-            int depMin = (departingRoute.departureTime[3] - '0') * 10 + (departingRoute.departureTime[4] - '0');
-
-            int arrMinutes = arrHour * 60 + arrMin;
-            int depMinutes = depHour * 60 + depMin;
-
-            if (depMinutes >= arrMinutes)
-            {
-                return (depMinutes - arrMinutes) / 60; // Hours
-            }
-            else
-            {
-                // Should not happen if canConnectTo is checked first
-                return 24; // Next day
-            }
-        }
-        else
-        {
-            // Different dates: calculate full layover including waiting days
-            int daysDifference = calculateDaysDifference(arrivingRoute.date, departingRoute.date);
-
-            int arrHour = (arrivingRoute.arrivalTime[0] - '0') * 10 + (arrivingRoute.arrivalTime[1] - '0');
-            int arrMin = (arrivingRoute.arrivalTime[3] - '0') * 10 + (arrivingRoute.arrivalTime[4] - '0');
-            int depHour = (departingRoute.departureTime[0] - '0') * 10 + (departingRoute.departureTime[1] - '0');
-            int depMin = (departingRoute.departureTime[3] - '0') * 10 + (departingRoute.departureTime[4] - '0');
-
-            int arrMinutes = arrHour * 60 + arrMin;
-            int depMinutes = depHour * 60 + depMin;
-
-            // Hours from arrival to midnight + full days waiting + hours from midnight to departure
-            int hoursToMidnight = (24 * 60 - arrMinutes) / 60; // Rest of arrival day
-            int fullDaysWaiting = (daysDifference - 1) * 24;   // Complete days between arrival and departure days
-            int hoursFromMidnight = depMinutes / 60;           // Partial day of departure
-
-            return hoursToMidnight + fullDaysWaiting + hoursFromMidnight;
+            // Should not happen if canConnectTo is checked first
+            return 0;
         }
+        return waitMinutes / 60;
     }
 
     // Helper: Calculate days difference between two dates (DD/MM/YYYY format)
     static int calculateDaysDifference(const std::string &fromDate, const std::string &toDate)
     {
-        int days = 0;
-        std::string current = fromDate;
-
-        while (current != toDate)
-        {
-            current = getNextDay(current);
-            days++;
-            if (days > 365)
-                break; // Safety check
-        }
-
-        return days;
+        return dayNumber(toDate) - dayNumber(fromDate);
     }
 
     // Check if this route can connect to another (arrival before next departure)
     bool canConnectTo(const Route &nextRoute) const
     {
-        // Allow any route that departs on or after arrival date
+        // Allow any route that departs at or after this arrival
         // (Ship can wait for multiple days if needed for cheaper route)
-        return compareDates(nextRoute.date, date) >= 0;
+        return nextRoute.departureStamp >= arrivalStamp;
     }
 
     // Helper: Compare two dates (DD/MM/YYYY format)
     // Returns: positive if date1 > date2, 0 if equal, negative if date1 < date2
     static int compareDates(const std::string &date1, const std::string &date2)
     {
-        // Extract day, month, year from DD/MM/YYYY
-        int day1 = std::stoi(date1.substr(0, 2));
-        int month1 = std::stoi(date1.substr(3, 2));
-        int year1 = std::stoi(date1.substr(6, 4));
-
-        int day2 = std::stoi(date2.substr(0, 2));
-        int month2 = std::stoi(date2.substr(3, 2));
-        int year2 = std::stoi(date2.substr(6, 4));
+        return dayNumber(date1) - dayNumber(date2);
+    }
 
-        // Compare years
-        if (year1 != year2)
-            return year1 - year2;
-        // Compare months
-        if (month1 != month2)
-            return month1 - month2;
-        // Compare days
-        return day1 - day2;
+private:
+    // Read the next unsigned number starting at pos, skipping one separator after it
+    static int readNumber(const std::string &str, size_t &pos)
+    {
+        int value = 0;
+        while (pos < str.length() && str[pos] >= '0' && str[pos] <= '9')
+        {
+            value = value * 10 + (str[pos] - '0');
+            pos++;
+        }
+        if (pos < str.length())
+        {
+            pos++;
+        }
+        return value;
     }
 };
-#endif
\ No newline at end of file
+#endif
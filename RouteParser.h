@@ -5,8 +5,11 @@
 
 #include "Graph.h"
 #include "HashTable.h"
+#include "ArrayList.h"
+#include "MappedFile.h"
 #include <fstream>
-#include <sstream>
+#include <cstring>
+#include <thread>
 using namespace std;
 class RouteParser {
 private:
@@ -113,90 +116,316 @@ private:
 
         else { port.x = 0; port.y = 0; }  // Default position for unknown ports
     }
-public:
-    // Parse PortCharges.txt
-    static HashTable<int> parsePortCharges(const string& filename) {
-        HashTable<int> portCharges;
-        ifstream file(filename);
+    static const int READ_CHUNK = 1 << 16;
+    static const int ROUTE_FIELDS = 7;
+    static const size_t MIN_PARALLEL_CHUNK = 1 << 20;
 
+    static bool isBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    // Split [begin, end) on blanks into at most maxFields tokens; returns how
+    // many were found (tokens past maxFields are ignored, as >> would)
+    static int splitFields(const char* begin, const char* end,
+        const char** fields, int* lengths, int maxFields) {
+        int count = 0;
+        const char* p = begin;
+        while (count < maxFields) {
+            while (p < end && isBlank(*p)) {
+                p++;
+            }
+            if (p == end) {
+                break;
+            }
+            const char* start = p;
+            while (p < end && !isBlank(*p)) {
+                p++;
+            }
+            fields[count] = start;
+            lengths[count] = static_cast<int>(p - start);
+            count++;
+        }
+        return count;
+    }
+
+    // Whole-token integer (optional sign); false if it is not a number
+    static bool parseInt(const char* text, int length, int& value) {
+        int i = 0;
+        bool negative = false;
+        if (i < length && (text[i] == '-' || text[i] == '+')) {
+            negative = text[i] == '-';
+            i++;
+        }
+        if (i == length) {
+            return false;
+        }
+        int result = 0;
+        for (; i < length; i++) {
+            if (text[i] < '0' || text[i] > '9') {
+                return false;
+            }
+            result = result * 10 + (text[i] - '0');
+        }
+        value = negative ? -result : result;
+        return true;
+    }
+
+    // Read the file in fixed-size chunks and hand every line to handleLine as
+    // a [begin, end) range inside the read buffer, without copying it out.
+    // A line cut off at the end of a chunk is moved to the front of the
+    // buffer and completed by the next read.
+    template <typename LineHandler>
+    static bool forEachLine(const string& filename, LineHandler handleLine) {
+        ifstream file(filename, ios::binary);
         if (!file.is_open()) {
-            return portCharges;
+            return false;
         }
 
-        string line;
-        while (getline(file, line)) {
-            istringstream iss(line);
-            string portName;
-            int charge;
+        int capacity = READ_CHUNK;
+        char* buffer = new char[capacity];
+        int carried = 0; // Bytes of an unfinished line at the buffer start
+
+        while (true) {
+            if (capacity - carried < READ_CHUNK / 2) {
+                // One line longer than the buffer: make room for the rest of it
+                char* bigger = new char[capacity * 2];
+                memcpy(bigger, buffer, carried);
+                delete[] buffer;
+                buffer = bigger;
+                capacity *= 2;
+            }
+            file.read(buffer + carried, capacity - carried);
+            int filled = carried + static_cast<int>(file.gcount());
+            if (filled == carried) {
+                break;
+            }
 
-            if (iss >> portName >> charge) {
-                portCharges.insert(portName, charge);
+            const char* lineStart = buffer;
+            const char* bufferEnd = buffer + filled;
+            const char* newline;
+            while ((newline = static_cast<const char*>(
+                        memchr(lineStart, '\n', bufferEnd - lineStart))) != nullptr) {
+                handleLine(lineStart, newline);
+                lineStart = newline + 1;
             }
+            carried = static_cast<int>(bufferEnd - lineStart);
+            memmove(buffer, lineStart, carried);
+        }
+        if (carried > 0) {
+            handleLine(buffer, buffer + carried); // Last line had no newline
         }
 
-        file.close();
-        return portCharges;
+        delete[] buffer;
+        return true;
     }
+    // One Routes.txt line: the seven fields as ranges into the line, plus
+    // the cost and stamps already converted
+    struct RouteLine {
+        const char* field[ROUTE_FIELDS];
+        int length[ROUTE_FIELDS];
+        int cost;
+        int departureStamp;
+        int arrivalStamp;
+    };
 
-    // Parse Routes.txt and build graph
-    static void buildGraphFromFile(Graph& graph, const string& routeFile,
-        const string& chargeFile) {
-        // First, parse port charges
-        HashTable<int> portCharges = parsePortCharges(chargeFile);
+    // Tokenize a line and work out its cost and stamps; false if it is not
+    // a route. Touches no shared state (scratch is the caller's), so worker
+    // threads can run it side by side.
+    static bool parseRouteLine(const char* begin, const char* end, Route& scratch, RouteLine& line) {
+        if (splitFields(begin, end, line.field, line.length, ROUTE_FIELDS) != ROUTE_FIELDS ||
+            !parseInt(line.field[5], line.length[5], line.cost)) {
+            return false;
+        }
+        scratch.date.assign(line.field[2], line.length[2]);
+        scratch.departureTime.assign(line.field[3], line.length[3]);
+        scratch.arrivalTime.assign(line.field[4], line.length[4]);
+        scratch.updateStamps();
+        line.departureStamp = scratch.departureStamp;
+        line.arrivalStamp = scratch.arrivalStamp;
+        return true;
+    }
 
-        // Parse routes and collect unique ports
-        ifstream file(routeFile);
-        if (!file.is_open()) {
-            return;
+    // Appends parsed lines to the graph in the order given: names are
+    // interned here, a port is added the first time it is seen (origin
+    // before destination, which fixes the port IDs) and the sailing goes
+    // into the graph's route store. Runs on one thread so that ports and
+    // routes are added in file order.
+    class GraphLoader {
+    private:
+        Graph& graph;
+        HashTable<int> portCharges;
+        ArrayList<int> portOfSymbol; // Symbol ID -> port ID, -1 if not looked up yet
+        Route route;                 // Reused for every line
+
+        void ensurePort(const Symbol& name) {
+            int id = name.getId();
+            while (portOfSymbol.getSize() <= id) {
+                portOfSymbol.push_back(-1);
+            }
+            if (portOfSymbol[id] == -1) {
+                if (!graph.hasPort(name)) {
+                    int charge = 0;
+                    portCharges.find(name, charge);
+                    Port port(name, 0, 0, charge);
+                    assignPortCoordinates(port);
+                    graph.addPort(port);
+                }
+                portOfSymbol[id] = graph.getPortId(name);
+            }
         }
 
-        HashTable<bool> uniquePorts;  // Track which ports we've seen
-        LinkedList<Route> routes;
+    public:
+        GraphLoader(Graph& g, const string& chargeFile)
+            : graph(g), portCharges(parsePortCharges(chargeFile)) {}
 
-        string line;
-        while (getline(file, line)) {
-            istringstream iss(line);
-            string origin, destination, date, depTime, arrTime, company;
-            int cost;
+        void add(const RouteLine& line) {
+            route.origin = Symbol(line.field[0], line.length[0]);
+            route.destination = Symbol(line.field[1], line.length[1]);
+            route.date.assign(line.field[2], line.length[2]);
+            route.departureTime.assign(line.field[3], line.length[3]);
+            route.arrivalTime.assign(line.field[4], line.length[4]);
+            route.cost = line.cost;
+            route.shippingCompany = Symbol(line.field[6], line.length[6]);
+            route.departureStamp = line.departureStamp;
+            route.arrivalStamp = line.arrivalStamp;
 
-            if (iss >> origin >> destination >> date >> depTime >> arrTime >> cost >> company) {
-                Route route(origin, destination, date, depTime, arrTime, cost, company);
-                routes.push_back(route);
+            ensurePort(route.origin);
+            ensurePort(route.destination);
+            graph.addRoute(route);
+        }
+
+        void finish(const string& routeFile) {
+            // Pack the routes into the graph's contiguous adjacency once
+            graph.buildAdjacency();
+
+            // Landmark tables live next to the routes file and are only rebuilt
+            // when the route network changes
+            string landmarkFile = routeFile + ".alt";
+            if (!graph.loadLandmarks(landmarkFile)) {
+                graph.saveLandmarks(landmarkFile);
+            }
+        }
+    };
+
+    // Parse the lines of [begin, end) into out (worker thread body)
+    static void parseRouteChunk(const char* begin, const char* end, ArrayList<RouteLine>* out) {
+        Route scratch;
+        RouteLine line;
+        const char* lineStart = begin;
+        while (lineStart < end) {
+            const char* newline = static_cast<const char*>(memchr(lineStart, '\n', end - lineStart));
+            const char* lineEnd = newline ? newline : end;
+            if (parseRouteLine(lineStart, lineEnd, scratch, line)) {
+                out->push_back(line);
+            }
+            lineStart = lineEnd + 1;
+        }
+    }
+
+    // Split the file into one byte range per thread, each moved forward to
+    // the start of a line, parse the ranges on worker threads into their own
+    // buffers, then add everything to the graph on this thread in file order
+    static void buildGraphInParallel(Graph& graph, const string& routeFile,
+        const string& chargeFile, int threadCount) {
+        MappedFile mapped;
+        if (!mapped.open(routeFile)) {
+            return;
+        }
+        const char* data = mapped.getData();
+        size_t size = mapped.getSize();
 
-                // Mark ports as seen
-                uniquePorts.insert(origin, true);
-                uniquePorts.insert(destination, true);
+        // Small files are not worth a thread per chunk
+        size_t maxChunks = size / MIN_PARALLEL_CHUNK;
+        int chunkCount = static_cast<size_t>(threadCount) < maxChunks ? threadCount : static_cast<int>(maxChunks);
+        if (chunkCount < 1) {
+            chunkCount = 1;
+        }
+
+        const char** bounds = new const char*[chunkCount + 1];
+        bounds[0] = data;
+        bounds[chunkCount] = data + size;
+        for (int c = 1; c < chunkCount; c++) {
+            const char* cut = data + size / chunkCount * c;
+            if (cut < bounds[c - 1]) {
+                cut = bounds[c - 1];
             }
+            const char* newline = static_cast<const char*>(memchr(cut, '\n', data + size - cut));
+            bounds[c] = newline ? newline + 1 : data + size;
         }
-        file.close();
 
-        // Add all unique ports to graph
-        for (int i = 0; i < routes.getSize(); i++) {
-            const Route& route = routes.get(i);
+        ArrayList<RouteLine>* chunks = new ArrayList<RouteLine>[chunkCount];
+        thread* workers = new thread[chunkCount];
+        for (int c = 1; c < chunkCount; c++) {
+            workers[c] = thread(parseRouteChunk, bounds[c], bounds[c + 1], &chunks[c]);
+        }
+        parseRouteChunk(bounds[0], bounds[1], &chunks[0]);
+        for (int c = 1; c < chunkCount; c++) {
+            workers[c].join();
+        }
 
-            // Add origin port if not already added
-            if (!graph.hasPort(route.origin)) {
-                int charge = 0;
-                portCharges.find(route.origin, charge);
-                Port originPort(route.origin, 0, 0, charge);
-                assignPortCoordinates(originPort);
-                graph.addPort(originPort);
+        GraphLoader loader(graph, chargeFile);
+        int total = 0;
+        for (int c = 0; c < chunkCount; c++) {
+            total += chunks[c].getSize();
+        }
+        graph.reserveRoutes(graph.getRouteCount() + total);
+        for (int c = 0; c < chunkCount; c++) {
+            for (int i = 0; i < chunks[c].getSize(); i++) {
+                loader.add(chunks[c][i]);
             }
+        }
+        delete[] workers;
+        delete[] chunks;
+        delete[] bounds;
 
-            // Add destination port if not already added
-            if (!graph.hasPort(route.destination)) {
-                int charge = 0;
-                portCharges.find(route.destination, charge);
-                Port destPort(route.destination, 0, 0, charge);
-                assignPortCoordinates(destPort);
-                graph.addPort(destPort);
+        loader.finish(routeFile);
+    }
+public:
+    // Parse PortCharges.txt
+    static HashTable<int> parsePortCharges(const string& filename) {
+        HashTable<int> portCharges;
+        forEachLine(filename, [&](const char* begin, const char* end) {
+            const char* fields[2];
+            int lengths[2];
+            int charge;
+            if (splitFields(begin, end, fields, lengths, 2) == 2 &&
+                parseInt(fields[1], lengths[1], charge)) {
+                portCharges.insert(string(fields[0], lengths[0]), charge);
             }
+        });
+        return portCharges;
+    }
+
+    // Parse Routes.txt and build graph. The file is streamed through a fixed
+    // read buffer and each line goes straight into the graph, with one Route
+    // reused for every line, so a line only allocates for a name that has
+    // never been seen before.
+    //
+    // threadCount > 1 (or 0 for one per core) maps the file instead and
+    // parses it in that many chunks on worker threads; the graph comes out
+    // the same either way.
+    static void buildGraphFromFile(Graph& graph, const string& routeFile,
+        const string& chargeFile, int threadCount = 1) {
+        if (threadCount == 0) {
+            threadCount = static_cast<int>(thread::hardware_concurrency());
+        }
+        if (threadCount > 1) {
+            buildGraphInParallel(graph, routeFile, chargeFile, threadCount);
+            return;
         }
 
-        // Add all routes to graph
-        for (int i = 0; i < routes.getSize(); i++) {
-            graph.addRoute(routes.get(i));
+        GraphLoader loader(graph, chargeFile);
+        Route scratch;
+        RouteLine line;
+        bool opened = forEachLine(routeFile, [&](const char* begin, const char* end) {
+            if (parseRouteLine(begin, end, scratch, line)) {
+                loader.add(line);
+            }
+        });
+        if (!opened) {
+            return;
         }
+        loader.finish(routeFile);
     }
 };
 
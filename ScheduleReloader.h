@@ -0,0 +1,151 @@
+#pragma once
+#ifndef SCHEDULERELOADER_H
+#define SCHEDULERELOADER_H
+#include "Graph.h"
+#include "ScheduleSnapshot.h"
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <string>
+using namespace std;
+// Serves the schedule as a shared_ptr to a fully built Graph and swaps in
+// a new one when Routes.txt or PortCharges.txt change, RCU style.
+//
+// A watcher thread polls both files; once either has changed and then both
+// stayed the same for one more poll (so a half-written file is not picked up), it
+// builds a new graph on its own (snapshot or parse, adjacency, reachability
+// and landmarks included) and publishes it with one atomic pointer store.
+// Readers take the current graph with acquire() and keep that pointer for
+// as long as they use it: a search that started on the old graph finishes
+// on it, and the old graph is freed when its last holder lets go. A
+// published graph's timetable is never changed by the reloader; only the
+// docking queues, which are live UI state, are carried over by whoever
+// adopts the new graph (Graph::copyDockingQueuesFrom).
+class ScheduleReloader
+{
+private:
+    string routeFile;
+    string chargeFile;
+    string snapshotFile;
+    int pollMilliseconds;
+
+    shared_ptr<Graph> current; // Only through atomic_load / atomic_store
+    atomic<int> generation;    // Graphs published so far
+
+    // Watcher thread state
+    long long seenStamps[4];    // Files the current graph was built from
+    long long pendingStamps[4]; // Files as of the previous poll
+    thread watcher;
+    mutex sleepLock;
+    condition_variable wakeUp;
+    bool stopping; // Guarded by sleepLock
+
+    void readStamps(long long stamps[4]) const
+    {
+        ScheduleSnapshot::sourceStamp(routeFile, stamps[0], stamps[1]);
+        ScheduleSnapshot::sourceStamp(chargeFile, stamps[2], stamps[3]);
+    }
+
+    static bool sameStamps(const long long a[4], const long long b[4])
+    {
+        return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+    }
+
+    static void copyStamps(long long to[4], const long long from[4])
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            to[i] = from[i];
+        }
+    }
+
+    // A complete graph from the files, nothing left to build lazily
+    shared_ptr<Graph> build() const
+    {
+        shared_ptr<Graph> graph = make_shared<Graph>();
+        ScheduleSnapshot::loadOrBuild(*graph, routeFile, chargeFile, snapshotFile, 0);
+        graph->buildAdjacency();
+        graph->getReachability();
+        graph->getLandmarks();
+        return graph;
+    }
+
+    void watch()
+    {
+        unique_lock<mutex> guard(sleepLock);
+        while (!stopping)
+        {
+            wakeUp.wait_for(guard, chrono::milliseconds(pollMilliseconds));
+            if (stopping)
+            {
+                break;
+            }
+            guard.unlock();
+
+            long long stamps[4];
+            readStamps(stamps);
+            if (!sameStamps(stamps, seenStamps) && sameStamps(stamps, pendingStamps))
+            {
+                // A missing or empty routes file keeps the schedule we have
+                shared_ptr<Graph> next = build();
+                if (next->getVertexCount() > 0)
+                {
+                    atomic_store(&current, next);
+                    generation++;
+                }
+                copyStamps(seenStamps, stamps);
+            }
+            copyStamps(pendingStamps, stamps);
+
+            guard.lock();
+        }
+    }
+
+public:
+    // Loads the schedule now and starts watching the files
+    ScheduleReloader(const string &routes, const string &charges, const string &snapshot,
+                     int pollMs = 2000)
+        : routeFile(routes), chargeFile(charges), snapshotFile(snapshot), pollMilliseconds(pollMs),
+          generation(1), stopping(false)
+    {
+        readStamps(seenStamps);
+        copyStamps(pendingStamps, seenStamps);
+        current = build();
+        watcher = thread(&ScheduleReloader::watch, this);
+    }
+
+    ~ScheduleReloader()
+    {
+        stop();
+    }
+
+    ScheduleReloader(const ScheduleReloader &) = delete;
+    ScheduleReloader &operator=(const ScheduleReloader &) = delete;
+
+    // The newest published graph; hold on to it for the whole search
+    shared_ptr<Graph> acquire() const
+    {
+        return atomic_load(&current);
+    }
+
+    // Bumped each time a reloaded graph is published
+    int getGeneration() const { return generation; }
+
+    // Stop watching (waits for a reload in progress to finish)
+    void stop()
+    {
+        {
+            lock_guard<mutex> guard(sleepLock);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        if (watcher.joinable())
+        {
+            watcher.join();
+        }
+    }
+};
+#endif
@@ -0,0 +1,493 @@
+#pragma once
+#ifndef SCHEDULESNAPSHOT_H
+#define SCHEDULESNAPSHOT_H
+#include "Graph.h"
+#include "RouteParser.h"
+#include "MappedFile.h"
+#include "HashTable.h"
+#include "ArrayList.h"
+#include "SymbolTable.h"
+#include <fstream>
+#include <cstring>
+#include <sys/stat.h>
+using namespace std;
+// Binary image of a loaded network, written once after the text files are
+// parsed and memory-mapped on later starts instead of parsing them again.
+//
+// Layout (native byte order, every section a multiple of 4 bytes):
+//   Header
+//   PortRecord  ports[portCount]                        by port ID
+//   int         nameOffsets[portCount + companyCount + 1]
+//   char        names[nameBytes]      port names, then company names by ID
+//   int         textOffsets[textCount + 1]
+//   char        text[textBytes]       distinct date and time strings
+//   RouteRecord routes[routeCount]                      in route index order
+//   int         departureOrder[routeCount]
+//   int         edgeOffsets[portCount + 1]
+//   Graph::Edge edges[routeCount]     sailings by origin, then departure
+//   int         inEdgeOffsets[portCount + 1]
+//   int         inEdges[routeCount]   reverse CSR (edge indices by destination)
+//   ReachabilityIndex image           see ReachabilityIndex::write
+//
+// Loading copies the tables into the graph's own arrays without sorting,
+// parsing or searching anything: names are interned once, routes take
+// their stamps as stored, and the CSR adjacency, its reverse and the
+// reachability tables are installed as saved (Graph::restoreAdjacency).
+// Each process holds its own copy; the mapping is only read from.
+// The header records the size and modification time of the text files it
+// came from, so an edited Routes.txt or PortCharges.txt is never shadowed
+// by an old snapshot.
+class ScheduleSnapshot
+{
+private:
+    static const int VERSION = 2;
+    static const int BYTE_ORDER_MARK = 0x01020304;
+    static const int MAX_COUNT = 1 << 28;
+
+    struct Header
+    {
+        char magic[4];        // "SNP1"
+        int byteOrder;        // BYTE_ORDER_MARK as the writer saw it
+        long long sources[4]; // Size and modification time of the routes, then the charges file
+        int version;
+        int portCount;
+        int companyCount;
+        int textCount;        // Distinct date/time strings
+        int routeCount;
+        int nameBytes;        // Padded to a multiple of 4
+        int textBytes;        // Padded to a multiple of 4
+        int reserved;
+    };
+
+    struct PortRecord
+    {
+        float x, y;
+        int dailyCharge;
+    };
+
+    struct RouteRecord
+    {
+        int origin;      // Port ID
+        int destination; // Port ID
+        int date;        // Text IDs
+        int departureTime;
+        int arrivalTime;
+        int cost;
+        int company;     // Company ID
+        int departureStamp;
+        int arrivalStamp;
+    };
+
+    // Byte offset of every section, from the counts in a header
+    struct Layout
+    {
+        size_t ports, nameOffsets, names, textOffsets, text, routes, order, edgeOffsets, edges;
+        size_t inEdgeOffsets, inEdges, reachability, end;
+
+        Layout(const Header &h)
+        {
+            ports = sizeof(Header);
+            nameOffsets = ports + sizeof(PortRecord) * size_t(h.portCount);
+            names = nameOffsets + sizeof(int) * (size_t(h.portCount) + h.companyCount + 1);
+            textOffsets = names + size_t(h.nameBytes);
+            text = textOffsets + sizeof(int) * (size_t(h.textCount) + 1);
+            routes = text + size_t(h.textBytes);
+            order = routes + sizeof(RouteRecord) * size_t(h.routeCount);
+            edgeOffsets = order + sizeof(int) * size_t(h.routeCount);
+            edges = edgeOffsets + sizeof(int) * (size_t(h.portCount) + 1);
+            inEdgeOffsets = edges + sizeof(Graph::Edge) * size_t(h.routeCount);
+            inEdges = inEdgeOffsets + sizeof(int) * (size_t(h.portCount) + 1);
+            reachability = inEdges + sizeof(int) * size_t(h.routeCount);
+            end = reachability + ReachabilityIndex::imageSize(h.portCount, h.companyCount);
+        }
+    };
+
+    // A source that is present must be the one the snapshot was taken from;
+    // a missing one (snapshot shipped on its own) is not held against it
+    static bool matchesSource(const Header &header, int which, const string &filename)
+    {
+        long long size, modified;
+        sourceStamp(filename, size, modified);
+        return size == -1 ||
+               (header.sources[2 * which] == size && header.sources[2 * which + 1] == modified);
+    }
+
+    static void appendString(string &chars, ArrayList<int> &offsets, const string &value)
+    {
+        chars += value;
+        offsets.push_back(static_cast<int>(chars.size()));
+    }
+
+    static void padToWord(string &chars)
+    {
+        while (chars.size() % 4 != 0)
+        {
+            chars += '\0';
+        }
+    }
+
+    // Offsets must start at 0, never decrease and stay inside the characters
+    static bool validOffsets(const int *offsets, int count, int bytes)
+    {
+        if (offsets[0] != 0)
+            return false;
+        for (int i = 0; i < count; i++)
+        {
+            if (offsets[i + 1] < offsets[i] || offsets[i + 1] > bytes)
+                return false;
+        }
+        return true;
+    }
+
+    static bool inRange(int value, int count)
+    {
+        return value >= 0 && value < count;
+    }
+
+public:
+    // Size and modification time of a file, -1 for both if it is missing.
+    // The time keeps the file system's full resolution (nanoseconds, 100 ns
+    // ticks on Windows), so a same-size rewrite within one second still
+    // counts as a change.
+    static void sourceStamp(const string &filename, long long &size, long long &modified)
+    {
+#ifdef _WIN32
+        WIN32_FILE_ATTRIBUTE_DATA info;
+        if (!GetFileAttributesExA(filename.c_str(), GetFileExInfoStandard, &info))
+        {
+            size = -1;
+            modified = -1;
+            return;
+        }
+        size = (static_cast<long long>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+        modified = (static_cast<long long>(info.ftLastWriteTime.dwHighDateTime) << 32) |
+                   info.ftLastWriteTime.dwLowDateTime;
+#else
+        struct stat info;
+        if (stat(filename.c_str(), &info) != 0)
+        {
+            size = -1;
+            modified = -1;
+            return;
+        }
+        size = static_cast<long long>(info.st_size);
+#ifdef __APPLE__
+        modified = static_cast<long long>(info.st_mtimespec.tv_sec) * 1000000000LL + info.st_mtimespec.tv_nsec;
+#else
+        modified = static_cast<long long>(info.st_mtim.tv_sec) * 1000000000LL + info.st_mtim.tv_nsec;
+#endif
+#endif
+    }
+
+    // Write the graph's network to filename, stamped with sources: the
+    // sourceStamp of the routes, then the charges file, taken before they
+    // were parsed. False if the file cannot be written or a route leads to
+    // a port the graph does not know (RouteParser never produces those).
+    static bool save(const Graph &graph, const string &filename, const long long sources[4])
+    {
+        Header header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, "SNP1", 4);
+        header.byteOrder = BYTE_ORDER_MARK;
+        for (int i = 0; i < 4; i++)
+        {
+            header.sources[i] = sources[i];
+        }
+        header.version = VERSION;
+        header.portCount = graph.getVertexCount();
+        header.companyCount = graph.getCompanyCount();
+        header.routeCount = graph.getRouteCount();
+
+        ArrayList<PortRecord> ports;
+        ArrayList<int> nameOffsets;
+        string names;
+        ports.reserve(header.portCount);
+        nameOffsets.reserve(header.portCount + header.companyCount + 1);
+        nameOffsets.push_back(0);
+        for (int p = 0; p < header.portCount; p++)
+        {
+            const Port &port = graph.getPortById(p);
+            PortRecord record;
+            record.x = port.x;
+            record.y = port.y;
+            record.dailyCharge = port.dailyCharge;
+            ports.push_back(record);
+            appendString(names, nameOffsets, port.name);
+        }
+        for (int c = 0; c < header.companyCount; c++)
+        {
+            appendString(names, nameOffsets, graph.getCompanyName(c));
+        }
+        padToWord(names);
+        header.nameBytes = static_cast<int>(names.size());
+
+        // Dates and times repeat across thousands of sailings; store each once
+        HashTable<int> textIds;
+        ArrayList<int> textOffsets;
+        string text;
+        textOffsets.push_back(0);
+        auto textId = [&](const string &value) {
+            int id;
+            if (!textIds.find(value, id))
+            {
+                id = textOffsets.getSize() - 1;
+                textIds.insert(value, id);
+                appendString(text, textOffsets, value);
+            }
+            return id;
+        };
+
+        ArrayList<RouteRecord> routes;
+        routes.reserve(header.routeCount);
+        for (int i = 0; i < header.routeCount; i++)
+        {
+            const Route &route = graph.getRouteByIndex(i);
+            RouteRecord record;
+            record.origin = graph.getRouteOriginId(i);
+            record.destination = graph.getPortId(route.destination);
+            if (record.destination == -1)
+            {
+                return false;
+            }
+            record.date = textId(route.date);
+            record.departureTime = textId(route.departureTime);
+            record.arrivalTime = textId(route.arrivalTime);
+            record.cost = route.cost;
+            record.company = graph.getCompanyId(route.shippingCompany);
+            record.departureStamp = route.departureStamp;
+            record.arrivalStamp = route.arrivalStamp;
+            routes.push_back(record);
+        }
+        padToWord(text);
+        header.textCount = textOffsets.getSize() - 1;
+        header.textBytes = static_cast<int>(text.size());
+
+        ArrayList<int> order;
+        order.reserve(header.routeCount);
+        for (int k = 0; k < header.routeCount; k++)
+        {
+            order.push_back(graph.getRouteByDepartureRank(k));
+        }
+        ArrayList<int> edgeOffsets;
+        ArrayList<int> inEdgeOffsets;
+        ArrayList<int> inEdges;
+        edgeOffsets.reserve(header.portCount + 1);
+        inEdgeOffsets.reserve(header.portCount + 1);
+        inEdges.reserve(header.routeCount);
+        for (int p = 0; p < header.portCount; p++)
+        {
+            edgeOffsets.push_back(graph.getEdgeBegin(p));
+            inEdgeOffsets.push_back(inEdges.getSize());
+            for (int i = graph.getInEdgeBegin(p); i < graph.getInEdgeEnd(p); i++)
+            {
+                inEdges.push_back(graph.getInEdge(i));
+            }
+        }
+        edgeOffsets.push_back(header.routeCount);
+        inEdgeOffsets.push_back(inEdges.getSize());
+        const ReachabilityIndex &reachability = graph.getReachability(); // Built here if not yet
+
+        ofstream file(filename, ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(ports.data()), sizeof(PortRecord) * header.portCount);
+        file.write(reinterpret_cast<const char *>(nameOffsets.data()), sizeof(int) * nameOffsets.getSize());
+        file.write(names.data(), names.size());
+        file.write(reinterpret_cast<const char *>(textOffsets.data()), sizeof(int) * textOffsets.getSize());
+        file.write(text.data(), text.size());
+        file.write(reinterpret_cast<const char *>(routes.data()), sizeof(RouteRecord) * header.routeCount);
+        file.write(reinterpret_cast<const char *>(order.data()), sizeof(int) * header.routeCount);
+        file.write(reinterpret_cast<const char *>(edgeOffsets.data()), sizeof(int) * edgeOffsets.getSize());
+        if (header.routeCount > 0)
+        {
+            file.write(reinterpret_cast<const char *>(&graph.getEdge(0)), sizeof(Graph::Edge) * header.routeCount);
+        }
+        file.write(reinterpret_cast<const char *>(inEdgeOffsets.data()), sizeof(int) * inEdgeOffsets.getSize());
+        file.write(reinterpret_cast<const char *>(inEdges.data()), sizeof(int) * inEdges.getSize());
+        reachability.write(file);
+        return file.good();
+    }
+
+    // Fill an empty graph from a snapshot. False (graph untouched) if the
+    // file is missing, damaged, from another version or byte order, or older
+    // than a routes/charges file that is present.
+    static bool load(Graph &graph, const string &filename,
+                     const string &routeFile, const string &chargeFile)
+    {
+        if (graph.getVertexCount() != 0 || graph.getRouteCount() != 0)
+        {
+            return false;
+        }
+
+        MappedFile mapped;
+        if (!mapped.open(filename) || mapped.getSize() < sizeof(Header))
+        {
+            return false;
+        }
+        const char *base = mapped.getData();
+        Header header;
+        memcpy(&header, base, sizeof(header));
+        if (memcmp(header.magic, "SNP1", 4) != 0 || header.byteOrder != BYTE_ORDER_MARK ||
+            header.version != VERSION ||
+            !matchesSource(header, 0, routeFile) || !matchesSource(header, 1, chargeFile))
+        {
+            return false;
+        }
+        if (!inRange(header.portCount, MAX_COUNT) || !inRange(header.companyCount, MAX_COUNT) ||
+            !inRange(header.textCount, MAX_COUNT) || !inRange(header.routeCount, MAX_COUNT) ||
+            !inRange(header.nameBytes, MAX_COUNT) || !inRange(header.textBytes, MAX_COUNT) ||
+            static_cast<long long>(header.portCount) * header.companyCount >= MAX_COUNT)
+        {
+            return false;
+        }
+        Layout layout(header);
+        if (layout.end != mapped.getSize())
+        {
+            return false;
+        }
+
+        const PortRecord *ports = reinterpret_cast<const PortRecord *>(base + layout.ports);
+        const int *nameOffsets = reinterpret_cast<const int *>(base + layout.nameOffsets);
+        const char *names = base + layout.names;
+        const int *textOffsets = reinterpret_cast<const int *>(base + layout.textOffsets);
+        const char *text = base + layout.text;
+        const RouteRecord *routes = reinterpret_cast<const RouteRecord *>(base + layout.routes);
+        const int *order = reinterpret_cast<const int *>(base + layout.order);
+        const int *edgeOffsets = reinterpret_cast<const int *>(base + layout.edgeOffsets);
+        const Graph::Edge *edges = reinterpret_cast<const Graph::Edge *>(base + layout.edges);
+        const int *inEdgeOffsets = reinterpret_cast<const int *>(base + layout.inEdgeOffsets);
+        const int *inEdges = reinterpret_cast<const int *>(base + layout.inEdges);
+
+        // Check every index before touching the graph
+        int nameCount = header.portCount + header.companyCount;
+        if (!validOffsets(nameOffsets, nameCount, header.nameBytes) ||
+            !validOffsets(textOffsets, header.textCount, header.textBytes) ||
+            !validOffsets(edgeOffsets, header.portCount, header.routeCount) ||
+            edgeOffsets[header.portCount] != header.routeCount ||
+            !validOffsets(inEdgeOffsets, header.portCount, header.routeCount) ||
+            inEdgeOffsets[header.portCount] != header.routeCount)
+        {
+            return false;
+        }
+        for (int i = 0; i < header.routeCount; i++)
+        {
+            const RouteRecord &r = routes[i];
+            const Graph::Edge &e = edges[i];
+            if (!inRange(r.origin, header.portCount) || !inRange(r.destination, header.portCount) ||
+                !inRange(r.date, header.textCount) || !inRange(r.departureTime, header.textCount) ||
+                !inRange(r.arrivalTime, header.textCount) || !inRange(r.company, header.companyCount) ||
+                !inRange(order[i], header.routeCount) || !inRange(e.routeIndex, header.routeCount) ||
+                !inRange(e.destination, header.portCount) || !inRange(e.company, header.companyCount))
+            {
+                return false;
+            }
+        }
+        for (int p = 0; p < header.portCount; p++)
+        {
+            for (int i = inEdgeOffsets[p]; i < inEdgeOffsets[p + 1]; i++)
+            {
+                if (!inRange(inEdges[i], header.routeCount) || edges[inEdges[i]].destination != p)
+                    return false;
+            }
+        }
+
+        ArrayList<Symbol> symbols;
+        symbols.reserve(nameCount);
+        for (int n = 0; n < nameCount; n++)
+        {
+            symbols.push_back(Symbol(names + nameOffsets[n], nameOffsets[n + 1] - nameOffsets[n]));
+        }
+        // Port IDs are positions in the table, so a repeated name is damage
+        ArrayList<bool> seen;
+        for (int p = 0; p < header.portCount; p++)
+        {
+            int id = symbols[p].getId();
+            while (seen.getSize() <= id)
+            {
+                seen.push_back(false);
+            }
+            if (seen[id])
+            {
+                return false;
+            }
+            seen[id] = true;
+        }
+
+        for (int p = 0; p < header.portCount; p++)
+        {
+            graph.addPort(Port(symbols[p], ports[p].x, ports[p].y, ports[p].dailyCharge));
+        }
+
+        ArrayList<string> texts;
+        texts.reserve(header.textCount);
+        for (int t = 0; t < header.textCount; t++)
+        {
+            texts.push_back(string(text + textOffsets[t], textOffsets[t + 1] - textOffsets[t]));
+        }
+
+        graph.reserveRoutes(header.routeCount);
+        Route route;
+        for (int i = 0; i < header.routeCount; i++)
+        {
+            const RouteRecord &r = routes[i];
+            route.origin = symbols[r.origin];
+            route.destination = symbols[r.destination];
+            route.date = texts[r.date];
+            route.departureTime = texts[r.departureTime];
+            route.arrivalTime = texts[r.arrivalTime];
+            route.cost = r.cost;
+            route.shippingCompany = symbols[header.portCount + r.company];
+            route.departureStamp = r.departureStamp;
+            route.arrivalStamp = r.arrivalStamp;
+            graph.addRoute(route);
+        }
+
+        ArrayList<string> companies;
+        companies.reserve(header.companyCount);
+        for (int c = 0; c < header.companyCount; c++)
+        {
+            companies.push_back(symbols[header.portCount + c]);
+        }
+        graph.restoreAdjacency(edgeOffsets, edges, order, companies.data(), header.companyCount,
+                               inEdgeOffsets, inEdges, base + layout.reachability);
+        return true;
+    }
+
+    // Startup path: the snapshot if it is current, otherwise parse the text
+    // files (threadCount as for RouteParser::buildGraphFromFile) and leave a
+    // fresh snapshot for next time. The files are stamped before parsing and
+    // again after; if either changed in between, what was parsed may be
+    // neither version, so no snapshot is written and the next start parses
+    // again.
+    static void loadOrBuild(Graph &graph, const string &routeFile, const string &chargeFile,
+                            const string &snapshotFile, int threadCount = 1)
+    {
+        if (!load(graph, snapshotFile, routeFile, chargeFile))
+        {
+            long long before[4], after[4];
+            sourceStamp(routeFile, before[0], before[1]);
+            sourceStamp(chargeFile, before[2], before[3]);
+            RouteParser::buildGraphFromFile(graph, routeFile, chargeFile, threadCount);
+            sourceStamp(routeFile, after[0], after[1]);
+            sourceStamp(chargeFile, after[2], after[3]);
+            bool unchanged = before[0] == after[0] && before[1] == after[1] &&
+                             before[2] == after[2] && before[3] == after[3];
+            if (graph.getVertexCount() > 0 && unchanged)
+            {
+                save(graph, snapshotFile, before);
+            }
+            return;
+        }
+
+        string landmarkFile = routeFile + ".alt";
+        if (!graph.loadLandmarks(landmarkFile))
+        {
+            graph.saveLandmarks(landmarkFile);
+        }
+    }
+};
+
+#endif
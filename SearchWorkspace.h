@@ -0,0 +1,160 @@
+#pragma once
+#ifndef SEARCHWORKSPACE_H
+#define SEARCHWORKSPACE_H
+#include "IndexedMinHeap.h"
+// Array whose entries all read as a default value until written, reset in
+// O(1): every entry carries the generation it was last written in, and
+// reset() just moves to a new generation instead of touching the entries.
+template <typename T>
+class StampedArray
+{
+private:
+    T *values;
+    unsigned int *stamps;
+    int capacity;
+    unsigned int generation;
+    T initial;
+
+public:
+    StampedArray() : values(nullptr), stamps(nullptr), capacity(0), generation(0), initial() {}
+    ~StampedArray()
+    {
+        delete[] values;
+        delete[] stamps;
+    }
+    StampedArray(const StampedArray &) = delete;
+    StampedArray &operator=(const StampedArray &) = delete;
+
+    // Start over with size entries, all reading as value
+    void reset(int size, const T &value)
+    {
+        initial = value;
+        if (size > capacity)
+        {
+            delete[] values;
+            delete[] stamps;
+            capacity = size;
+            values = new T[capacity];
+            stamps = new unsigned int[capacity];
+            for (int i = 0; i < capacity; i++)
+            {
+                stamps[i] = 0;
+            }
+            generation = 0;
+        }
+        generation++;
+        if (generation == 0)
+        {
+            // Wrapped around: old stamps could look current again
+            for (int i = 0; i < capacity; i++)
+            {
+                stamps[i] = 0;
+            }
+            generation = 1;
+        }
+    }
+
+    // Entry for writing (or reading); first access this generation sets it
+    // to the initial value
+    T &operator[](int index)
+    {
+        if (stamps[index] != generation)
+        {
+            stamps[index] = generation;
+            values[index] = initial;
+        }
+        return values[index];
+    }
+
+    T get(int index) const
+    {
+        return stamps[index] == generation ? values[index] : initial;
+    }
+};
+
+// Scratch state for one search at a time, kept across queries so that a
+// query allocates nothing once the buffers have grown to the network size.
+// Searches ask for numbered slots; a slot's contents last until the same
+// slot is asked for again. Not shared between threads: each finder owns
+// one, so use one finder per thread.
+class SearchWorkspace
+{
+public:
+    static const int INT_SLOTS = 6;
+    static const int FLAG_SLOTS = 3;
+    static const int FRONTIER_SLOTS = 2;
+
+private:
+    StampedArray<int> intArrays[INT_SLOTS];
+    StampedArray<bool> flagArrays[FLAG_SLOTS];
+    IndexedMinHeap<int> *frontiers[FRONTIER_SLOTS];
+    bool *buffers[FLAG_SLOTS];
+    int bufferCapacity[FLAG_SLOTS];
+
+public:
+    SearchWorkspace()
+    {
+        for (int i = 0; i < FRONTIER_SLOTS; i++)
+        {
+            frontiers[i] = nullptr;
+        }
+        for (int i = 0; i < FLAG_SLOTS; i++)
+        {
+            buffers[i] = nullptr;
+            bufferCapacity[i] = 0;
+        }
+    }
+    ~SearchWorkspace()
+    {
+        for (int i = 0; i < FRONTIER_SLOTS; i++)
+        {
+            delete frontiers[i];
+        }
+        for (int i = 0; i < FLAG_SLOTS; i++)
+        {
+            delete[] buffers[i];
+        }
+    }
+    SearchWorkspace(const SearchWorkspace &) = delete;
+    SearchWorkspace &operator=(const SearchWorkspace &) = delete;
+
+    // size entries reading as initial
+    StampedArray<int> &ints(int slot, int size, int initial)
+    {
+        intArrays[slot].reset(size, initial);
+        return intArrays[slot];
+    }
+
+    // size entries reading as false
+    StampedArray<bool> &flags(int slot, int size)
+    {
+        flagArrays[slot].reset(size, false);
+        return flagArrays[slot];
+    }
+
+    // Empty frontier over keys [0, size)
+    IndexedMinHeap<int> &frontier(int slot, int size)
+    {
+        if (frontiers[slot] == nullptr || frontiers[slot]->getCapacity() < size)
+        {
+            delete frontiers[slot];
+            frontiers[slot] = new IndexedMinHeap<int>(size);
+        }
+        frontiers[slot]->clear();
+        return *frontiers[slot];
+    }
+
+    // Plain bool array of at least size entries, contents undefined (for
+    // callees that overwrite every entry, e.g. findPortsReaching)
+    bool *buffer(int slot, int size)
+    {
+        if (bufferCapacity[slot] < size)
+        {
+            delete[] buffers[slot];
+            bufferCapacity[slot] = size > 0 ? size : 1;
+            buffers[slot] = new bool[bufferCapacity[slot]];
+        }
+        return buffers[slot];
+    }
+};
+#endif
@@ -2,8 +2,8 @@
 #define SHORTEST_PATH_FINDER_H
 
 #include "PathFinder.h"
-#include "LinkedList.h"
-#include "PortMapper.h"
+#include "ArrayList.h"
+#include "SearchWorkspace.h"
 #include <limits>
 #include <cmath>
 using namespace std;
@@ -11,10 +11,15 @@ class ShortestPathFinder
 {
 private:
     Graph *graph;
+    SearchWorkspace workspace; // Search arrays reused across queries
+    PreferenceMask preferenceMask; // Preferences of the current query as bitsets
 
 public:
     ShortestPathFinder(Graph *g) : graph(g) {}
 
+    // Search a different graph from the next query on (schedule reload)
+    void setGraph(Graph *g) { graph = g; }
+
     // Find shortest path (minimum hops/distance) - same result for both standard and bidirectional
     PathResult findShortestPath(const string &origin,
                                 const string &destination,
@@ -36,21 +41,13 @@ public:
             return result;
         }
 
-        // Build port mapper
-        PortMapper portMapper;
-        LinkedList<Port> allPorts = graph->getAllPorts();
-
-        for (int i = 0; i < allPorts.getSize(); i++)
-        {
-            portMapper.addPort(allPorts.get(i).name);
-        }
-
-        int numPorts = portMapper.getSize();
+        // Port IDs from the graph are dense, so they index the search arrays directly
+        int numPorts = graph->getVertexCount();
         cout << "Mapped " << numPorts << " ports" << endl;
 
         // Get indices
-        int originIdx = portMapper.findIndex(origin);
-        int destIdx = portMapper.findIndex(destination);
+        int originIdx = graph->getPortId(origin);
+        int destIdx = graph->getPortId(destination);
 
         if (originIdx == -1 || destIdx == -1)
         {
@@ -59,27 +56,15 @@ public:
         }
 
         // Arrays for Dijkstra - minimize hops instead of cost
-        int *hops = new int[numPorts]; // Number of hops (routes taken)
-        int *parent = new int[numPorts];
-        bool *visited = new bool[numPorts];
-        int *totalCost = new int[numPorts]; // Store actual cost for display, but optimize by hops
-        string *arrivalDates = new string[numPorts];
-        string *arrivalTimes = new string[numPorts];
-
-        for (int i = 0; i < numPorts; i++)
-        {
-            hops[i] = numeric_limits<int>::max();
-            totalCost[i] = numeric_limits<int>::max();
-            parent[i] = -1;
-            visited[i] = false;
-            arrivalDates[i] = "";
-            arrivalTimes[i] = "";
-        }
+        StampedArray<int> &hops = workspace.ints(0, numPorts, numeric_limits<int>::max()); // Number of hops (routes taken)
+        StampedArray<int> &parent = workspace.ints(1, numPorts, -1);
+        StampedArray<bool> &visited = workspace.flags(0, numPorts);
+        StampedArray<int> &totalCost = workspace.ints(3, numPorts, numeric_limits<int>::max()); // Store actual cost for display, but optimize by hops
+        StampedArray<int> &arrivalStamps = workspace.ints(2, numPorts, -1); // Arrival timestamp at each port
 
         hops[originIdx] = 0;
         totalCost[originIdx] = 0;
-        arrivalDates[originIdx] = date;
-        arrivalTimes[originIdx] = "00:00";
+        arrivalStamps[originIdx] = Route::toTimestamp(date, "00:00"); // Start at beginning of day
 
         cout << "Running Dijkstra's algorithm for shortest path (minimum hops)..." << endl;
 
@@ -114,69 +99,35 @@ public:
             }
 
             // Update neighbors
-            string currentPort = portMapper.getName(minIdx);
-            string currentArrivalDate = arrivalDates[minIdx];
-            string currentArrivalTime = arrivalTimes[minIdx];
+            int currentArrivalStamp = arrivalStamps[minIdx];
 
-            LinkedList<Route> connectingRoutes = graph->getConnectingRoutes(
-                currentPort, currentArrivalDate, currentArrivalTime);
+            Graph::EdgeRange connectingRoutes = graph->getDeparturesAfter(minIdx, currentArrivalStamp);
 
-            for (int i = 0; i < connectingRoutes.getSize(); i++)
+            for (const Graph::Edge *edge = connectingRoutes.begin(); edge != connectingRoutes.end(); edge++)
             {
-                const Route &route = connectingRoutes.get(i);
-                int neighborIdx = portMapper.findIndex(route.destination);
+                const Route &route = graph->getRouteByIndex(edge->routeIndex);
+                int neighborIdx = edge->destination;
 
                 if (neighborIdx == -1 || visited[neighborIdx])
                     continue;
 
-                // Calculate layover hours and port charge
+                // Wait since arriving here (every departure in the range leaves at or
+                // after that arrival); the origin has no layover
                 int layoverHours = 0;
                 int portCharge = 0;
-                bool connectionValid = true;
-
                 if (parent[minIdx] != -1)
                 {
-                    string fromPort = portMapper.getName(parent[minIdx]);
-                    string toPort = currentPort;
-                    string prevArrivalDate = arrivalDates[minIdx];
-                    string prevArrivalTime = arrivalTimes[minIdx];
-
-                    LinkedList<Route> prevRoutes = graph->getConnectingRoutes(fromPort, arrivalDates[parent[minIdx]], arrivalTimes[parent[minIdx]]);
-                    for (int j = 0; j < prevRoutes.getSize(); j++)
-                    {
-                        if (prevRoutes.get(j).destination == toPort &&
-                            prevRoutes.get(j).date == prevArrivalDate)
-                        {
-                            const Route &previousRoute = prevRoutes.get(j);
-                            if (!previousRoute.canConnectTo(route))
-                            {
-                                connectionValid = false;
-                            }
-                            else
-                            {
-                                layoverHours = Route::calculateLayoverHours(previousRoute, route);
-                            }
-                            break;
-                        }
-                    }
-                }
-
-                if (!connectionValid)
-                {
-                    continue;
+                    layoverHours = (edge->departure - currentArrivalStamp) / 60;
                 }
 
                 // Apply port charge if layover > 12 hours
                 if (layoverHours > 12)
                 {
-                    Port currentPortInfo;
-                    if (graph->getPort(currentPort, currentPortInfo))
-                    {
-                        int days = (layoverHours + 11) / 24;
-                        if (days == 0)
-                            days = 1;
-                        portCharge = currentPortInfo.dailyCharge * days;
-                    }
+                    const Port &currentPortInfo = graph->getPortById(minIdx);
+                    int days = (layoverHours + 11) / 24;
+                    if (days == 0)
+                        days = 1;
+                    portCharge = currentPortInfo.dailyCharge * days;
                 }
 
                 // Optimize by hops, not cost
@@ -188,16 +139,14 @@ public:
                     hops[neighborIdx] = newHops;
                     totalCost[neighborIdx] = newCost;
                     parent[neighborIdx] = minIdx;
-                    arrivalDates[neighborIdx] = route.date;
-                    arrivalTimes[neighborIdx] = route.arrivalTime;
+                    arrivalStamps[neighborIdx] = route.arrivalStamp;
                 }
                 // If same number of hops, choose the one with lower cost
                 else if (newHops == hops[neighborIdx] && newCost < totalCost[neighborIdx])
                 {
                     totalCost[neighborIdx] = newCost;
                     parent[neighborIdx] = minIdx;
-                    arrivalDates[neighborIdx] = route.date;
-                    arrivalTimes[neighborIdx] = route.arrivalTime;
+                    arrivalStamps[neighborIdx] = route.arrivalStamp;
                 }
             }
         }
@@ -207,7 +156,7 @@ public:
         {
             cout << "Reconstructing shortest path..." << endl;
 
-            LinkedList<int> pathIndices;
+            ArrayList<int> pathIndices;
             int current = destIdx;
             while (current != -1)
             {
@@ -218,7 +167,7 @@ public:
             // Reverse to get correct order
             for (int i = pathIndices.getSize() - 1; i >= 0; i--)
             {
-                result.path.push_back(portMapper.getName(pathIndices.get(i)));
+                result.path.push_back(graph->getPortName(pathIndices.get(i)));
             }
 
             // Reconstruct routes by querying the graph
@@ -226,17 +175,16 @@ public:
             {
                 int fromIdx = pathIndices.get(i);
                 int toIdx = pathIndices.get(i - 1);
-                string fromPort = portMapper.getName(fromIdx);
-                string toPort = portMapper.getName(toIdx);
-                string departDate = arrivalDates[fromIdx];
-                string departTime = arrivalTimes[fromIdx];
-                string arriveDate = arrivalDates[toIdx];
+                string fromPort = graph->getPortName(fromIdx);
+                string toPort = graph->getPortName(toIdx);
+                int departStamp = arrivalStamps[fromIdx];
+                int arriveStamp = arrivalStamps[toIdx];
 
                 // Find the route used
-                LinkedList<Route> routes = graph->getConnectingRoutes(fromPort, departDate, departTime);
+                Graph::RouteView routes = graph->getConnectingRoutes(fromPort, departStamp);
                 for (int j = 0; j < routes.getSize(); j++)
                 {
-                    if (routes.get(j).destination == toPort && routes.get(j).date == arriveDate)
+                    if (routes.get(j).destination == toPort && routes.get(j).arrivalStamp == arriveStamp)
                     {
                         result.routes.push_back(routes.get(j));
                         break;
@@ -268,7 +216,7 @@ public:
                 }
 
                 LayoverInfo layover(layoverPort, layoverHours, portCharge,
-                                    arrivingRoute.date, arrivingRoute.arrivalTime,
+                                    Route::dateFromTimestamp(arrivingRoute.arrivalStamp), arrivingRoute.arrivalTime,
                                     departingRoute.date, departingRoute.departureTime);
                 result.layovers.push_back(layover);
             }
@@ -327,19 +275,9 @@ public:
             }
             cout << "  Total Cost: $" << result.totalCost << " (Hops: " << hops[destIdx] << ")" << endl;
 
-            // Calculate total travel time (route times + layover times)
-            int totalTravelHours = 0;
-            for (int i = 0; i < result.routes.getSize(); i++)
-            {
-                const Route &route = result.routes.get(i);
-                // Each route takes approximately 24 hours (1 day travel)
-                totalTravelHours += 24;
-            }
-            // Add layover hours
-            for (int i = 0; i < result.layovers.getSize(); i++)
-            {
-                totalTravelHours += result.layovers.get(i).layoverHours;
-            }
+            // Total travel time: first departure to final arrival (sailing + layovers)
+            int totalTravelHours = (result.routes.get(result.routes.getSize() - 1).arrivalStamp -
+                                    result.routes.get(0).departureStamp) / 60;
             result.totalTravelTime = totalTravelHours;
             cout << "  Total Travel Time: " << totalTravelHours << " hours ("
                  << (totalTravelHours / 24) << " days " << (totalTravelHours % 24) << " hours)" << endl;
@@ -349,13 +287,6 @@ public:
             cout << "No path found to destination!" << endl;
         }
 
-        delete[] hops;
-        delete[] parent;
-        delete[] visited;
-        delete[] totalCost;
-        delete[] arrivalDates;
-        delete[] arrivalTimes;
-
         return result;
     }
 
@@ -381,20 +312,12 @@ public:
             return result;
         }
 
-        // Build port mapper
-        PortMapper portMapper;
-        LinkedList<Port> allPorts = graph->getAllPorts();
-
-        for (int i = 0; i < allPorts.getSize(); i++)
-        {
-            portMapper.addPort(allPorts.get(i).name);
-        }
-
-        int numPorts = portMapper.getSize();
+        // Interned port IDs from the graph
+        int numPorts = graph->getVertexCount();
         cout << "Mapped " << numPorts << " ports with preference filtering..." << endl;
 
-        int originIdx = portMapper.findIndex(origin);
-        int destIdx = portMapper.findIndex(destination);
+        int originIdx = graph->getPortId(origin);
+        int destIdx = graph->getPortId(destination);
 
         if (originIdx == -1 || destIdx == -1)
         {
@@ -403,27 +326,18 @@ public:
         }
 
         // Arrays for Dijkstra with preferences
-        int *hops = new int[numPorts];
-        int *parent = new int[numPorts];
-        bool *visited = new bool[numPorts];
-        int *totalCost = new int[numPorts];
-        string *arrivalDates = new string[numPorts];
-        string *arrivalTimes = new string[numPorts];
-
-        for (int i = 0; i < numPorts; i++)
-        {
-            hops[i] = numeric_limits<int>::max();
-            totalCost[i] = numeric_limits<int>::max();
-            parent[i] = -1;
-            visited[i] = false;
-            arrivalDates[i] = "";
-            arrivalTimes[i] = "";
-        }
+        StampedArray<int> &hops = workspace.ints(0, numPorts, numeric_limits<int>::max());
+        StampedArray<int> &parent = workspace.ints(1, numPorts, -1);
+        StampedArray<bool> &visited = workspace.flags(0, numPorts);
+        StampedArray<int> &totalCost = workspace.ints(3, numPorts, numeric_limits<int>::max());
+        StampedArray<int> &arrivalStamps = workspace.ints(2, numPorts, -1); // Arrival timestamp at each port
+
+        // Preferences as bitsets over port and company IDs
+        preferenceMask.compile(preferences, *graph);
 
         hops[originIdx] = 0;
         totalCost[originIdx] = 0;
-        arrivalDates[originIdx] = date;
-        arrivalTimes[originIdx] = "00:00";
+        arrivalStamps[originIdx] = Route::toTimestamp(date, "00:00"); // Start at beginning of day
 
         cout << "Running Dijkstra's algorithm for shortest path with preference filtering..." << endl;
 
@@ -454,94 +368,41 @@ public:
                 break;
             }
 
-            string currentPort = portMapper.getName(minIdx);
-            string currentArrivalDate = arrivalDates[minIdx];
-            string currentArrivalTime = arrivalTimes[minIdx];
+            int currentArrivalStamp = arrivalStamps[minIdx];
 
-            LinkedList<Route> connectingRoutes = graph->getConnectingRoutes(
-                currentPort, currentArrivalDate, currentArrivalTime);
+            Graph::EdgeRange connectingRoutes = graph->getDeparturesAfter(minIdx, currentArrivalStamp);
 
-            for (int i = 0; i < connectingRoutes.getSize(); i++)
+            for (const Graph::Edge *edge = connectingRoutes.begin(); edge != connectingRoutes.end(); edge++)
             {
-                const Route &route = connectingRoutes.get(i);
-
                 // Apply preference filter
-                if (!preferences.matchesRoute(route))
+                if (!preferenceMask.allows(minIdx, *edge))
                 {
                     continue;
                 }
 
-                int neighborIdx = portMapper.findIndex(route.destination);
+                const Route &route = graph->getRouteByIndex(edge->routeIndex);
+
+                int neighborIdx = edge->destination;
 
                 if (neighborIdx == -1 || visited[neighborIdx])
                     continue;
 
-                // Check if neighbor is excluded
-                if (preferences.hasPortPreference)
-                {
-                    bool isExcluded = false;
-                    if (preferences.excludedPorts.getSize() > 0)
-                    {
-                        for (int k = 0; k < preferences.excludedPorts.getSize(); k++)
-                        {
-                            if (preferences.excludedPorts.get(k) == route.destination)
-                            {
-                                isExcluded = true;
-                                break;
-                            }
-                        }
-                    }
-                    if (isExcluded)
-                        continue;
-                }
-
-                // Calculate layover hours
+                // Wait since arriving here (every departure in the range leaves at or
+                // after that arrival); the origin has no layover
                 int layoverHours = 0;
-                bool connectionValid = true;
-
                 if (parent[minIdx] != -1)
                 {
-                    string fromPort = portMapper.getName(parent[minIdx]);
-                    string toPort = currentPort;
-                    string prevArrivalDate = arrivalDates[minIdx];
-                    string prevArrivalTime = arrivalTimes[minIdx];
-
-                    LinkedList<Route> prevRoutes = graph->getConnectingRoutes(fromPort, arrivalDates[parent[minIdx]], arrivalTimes[parent[minIdx]]);
-                    for (int j = 0; j < prevRoutes.getSize(); j++)
-                    {
-                        if (prevRoutes.get(j).destination == toPort &&
-                            prevRoutes.get(j).date == prevArrivalDate)
-                        {
-                            const Route &previousRoute = prevRoutes.get(j);
-                            if (!previousRoute.canConnectTo(route))
-                            {
-                                connectionValid = false;
-                            }
-                            else
-                            {
-                                layoverHours = Route::calculateLayoverHours(previousRoute, route);
-                            }
-                            break;
-                        }
-                    }
-                }
-
-                if (!connectionValid)
-                {
-                    continue;
+                    layoverHours = (edge->departure - currentArrivalStamp) / 60;
                 }
 
                 int portCharge = 0;
                 if (layoverHours > 12)
                 {
-                    Port currentPortInfo;
-                    if (graph->getPort(currentPort, currentPortInfo))
-                    {
-                        int days = (layoverHours + 11) / 24;
-                        if (days == 0)
-                            days = 1;
-                        portCharge = currentPortInfo.dailyCharge * days;
-                    }
+                    const Port &currentPortInfo = graph->getPortById(minIdx);
+                    int days = (layoverHours + 11) / 24;
+                    if (days == 0)
+                        days = 1;
+                    portCharge = currentPortInfo.dailyCharge * days;
                 }
 
                 int newHops = hops[minIdx] + 1;
@@ -552,15 +413,13 @@ public:
                     hops[neighborIdx] = newHops;
                     totalCost[neighborIdx] = newCost;
                     parent[neighborIdx] = minIdx;
-                    arrivalDates[neighborIdx] = route.date;
-                    arrivalTimes[neighborIdx] = route.arrivalTime;
+                    arrivalStamps[neighborIdx] = route.arrivalStamp;
                 }
                 else if (newHops == hops[neighborIdx] && newCost < totalCost[neighborIdx])
                 {
                     totalCost[neighborIdx] = newCost;
                     parent[neighborIdx] = minIdx;
-                    arrivalDates[neighborIdx] = route.date;
-                    arrivalTimes[neighborIdx] = route.arrivalTime;
+                    arrivalStamps[neighborIdx] = route.arrivalStamp;
                 }
             }
         }
@@ -570,7 +429,7 @@ public:
         {
             cout << "Reconstructing shortest path..." << endl;
 
-            LinkedList<int> pathIndices;
+            ArrayList<int> pathIndices;
             int current = destIdx;
             while (current != -1)
             {
@@ -580,23 +439,22 @@ public:
 
             for (int i = pathIndices.getSize() - 1; i >= 0; i--)
             {
-                result.path.push_back(portMapper.getName(pathIndices.get(i)));
+                result.path.push_back(graph->getPortName(pathIndices.get(i)));
             }
 
             for (int i = pathIndices.getSize() - 1; i > 0; i--)
             {
                 int fromIdx = pathIndices.get(i);
                 int toIdx = pathIndices.get(i - 1);
-                string fromPort = portMapper.getName(fromIdx);
-                string toPort = portMapper.getName(toIdx);
-                string departDate = arrivalDates[fromIdx];
-                string departTime = arrivalTimes[fromIdx];
-                string arriveDate = arrivalDates[toIdx];
+                string fromPort = graph->getPortName(fromIdx);
+                string toPort = graph->getPortName(toIdx);
+                int departStamp = arrivalStamps[fromIdx];
+                int arriveStamp = arrivalStamps[toIdx];
 
-                LinkedList<Route> routes = graph->getConnectingRoutes(fromPort, departDate, departTime);
+                Graph::RouteView routes = graph->getConnectingRoutes(fromPort, departStamp);
                 for (int j = 0; j < routes.getSize(); j++)
                 {
-                    if (routes.get(j).destination == toPort && routes.get(j).date == arriveDate)
+                    if (routes.get(j).destination == toPort && routes.get(j).arrivalStamp == arriveStamp)
                     {
                         result.routes.push_back(routes.get(j));
                         break;
@@ -626,7 +484,7 @@ public:
                 }
 
                 LayoverInfo layover(layoverPort, layoverHours, portCharge,
-                                    arrivingRoute.date, arrivingRoute.arrivalTime,
+                                    Route::dateFromTimestamp(arrivingRoute.arrivalStamp), arrivingRoute.arrivalTime,
                                     departingRoute.date, departingRoute.departureTime);
                 result.layovers.push_back(layover);
             }
@@ -685,19 +543,9 @@ public:
             }
             cout << "  Total Cost: $" << result.totalCost << " (Hops: " << hops[destIdx] << ")" << endl;
 
-            // Calculate total travel time (route times + layover times)
-            int totalTravelHours = 0;
-            for (int i = 0; i < result.routes.getSize(); i++)
-            {
-                const Route &route = result.routes.get(i);
-                // Each route takes approximately 24 hours (1 day travel)
-                totalTravelHours += 24;
-            }
-            // Add layover hours
-            for (int i = 0; i < result.layovers.getSize(); i++)
-            {
-                totalTravelHours += result.layovers.get(i).layoverHours;
-            }
+            // Total travel time: first departure to final arrival (sailing + layovers)
+            int totalTravelHours = (result.routes.get(result.routes.getSize() - 1).arrivalStamp -
+                                    result.routes.get(0).departureStamp) / 60;
             result.totalTravelTime = totalTravelHours;
             cout << "  Total Travel Time: " << totalTravelHours << " hours ("
                  << (totalTravelHours / 24) << " days " << (totalTravelHours % 24) << " hours)" << endl;
@@ -707,13 +555,6 @@ public:
             cout << "No path found to destination with given preferences!" << endl;
         }
 
-        delete[] hops;
-        delete[] parent;
-        delete[] visited;
-        delete[] totalCost;
-        delete[] arrivalDates;
-        delete[] arrivalTimes;
-
         return result;
     }
 };
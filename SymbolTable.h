@@ -0,0 +1,212 @@
+#pragma once
+#ifndef SYMBOLTABLE_H
+#define SYMBOLTABLE_H
+#include <string>
+#include <cstring>
+#include <ostream>
+#include <mutex>
+using namespace std;
+#include "HashTable.h"
+// Process-wide table of interned names (ports, shipping companies). Each
+// distinct name is stored once and identified by a dense integer ID; ID 0
+// is the empty name. Names live in fixed-size blocks that never move, so a
+// reference returned by getName stays valid for the life of the program.
+// The index from name to ID holds only hashes and IDs and compares a
+// candidate against its block, so the characters are not kept twice.
+//
+// Safe to use from several threads (e.g. a schedule reloading in the
+// background): intern and lookup take a lock, while getName takes none,
+// since neither the block directory nor the blocks ever move and a thread
+// only holds IDs that were handed to it after they were written.
+class SymbolTable
+{
+private:
+    static const int BLOCK_SIZE = 1024;
+    static const int MAX_BLOCKS = 16384; // Room for 16M distinct names
+
+    // Name index slot, open addressing with linear probing
+    struct Slot
+    {
+        unsigned int hash; // HashTable::hashOf of the name
+        int id;            // -1 if empty
+    };
+
+    Slot *slots;                // Power-of-two count, at most half full
+    int slotCount;
+    string *blocks[MAX_BLOCKS]; // ID / BLOCK_SIZE -> block of names
+    int count;
+    mutable mutex lock;
+
+    SymbolTable() : slots(nullptr), slotCount(0), count(0)
+    {
+        for (int i = 0; i < MAX_BLOCKS; i++)
+        {
+            blocks[i] = nullptr;
+        }
+        resize(BLOCK_SIZE);
+        intern("");
+    }
+
+    // ID of the characters [name, name + length), or -1 (lock held)
+    int find(const char *name, int length, unsigned int hash) const
+    {
+        int mask = slotCount - 1;
+        for (int index = static_cast<int>(hash) & mask; slots[index].id != -1; index = (index + 1) & mask)
+        {
+            if (slots[index].hash == hash)
+            {
+                const string &stored = getName(slots[index].id);
+                if (static_cast<int>(stored.size()) == length && memcmp(stored.data(), name, length) == 0)
+                {
+                    return slots[index].id;
+                }
+            }
+        }
+        return -1;
+    }
+
+    void place(unsigned int hash, int id)
+    {
+        int mask = slotCount - 1;
+        int index = static_cast<int>(hash) & mask;
+        while (slots[index].id != -1)
+        {
+            index = (index + 1) & mask;
+        }
+        slots[index].hash = hash;
+        slots[index].id = id;
+    }
+
+    // Move every ID to a table of newCount slots by its stored hash
+    void resize(int newCount)
+    {
+        Slot *old = slots;
+        int oldCount = slotCount;
+        slots = new Slot[newCount];
+        slotCount = newCount;
+        for (int i = 0; i < newCount; i++)
+        {
+            slots[i].id = -1;
+        }
+        for (int i = 0; i < oldCount; i++)
+        {
+            if (old[i].id != -1)
+            {
+                place(old[i].hash, old[i].id);
+            }
+        }
+        delete[] old;
+    }
+
+public:
+    SymbolTable(const SymbolTable &) = delete;
+    SymbolTable &operator=(const SymbolTable &) = delete;
+    ~SymbolTable()
+    {
+        for (int i = 0; i < MAX_BLOCKS && blocks[i] != nullptr; i++)
+        {
+            delete[] blocks[i];
+        }
+        delete[] slots;
+    }
+
+    static SymbolTable &global()
+    {
+        static SymbolTable table;
+        return table;
+    }
+
+    // ID of name, adding it if it is new
+    int intern(const string &name)
+    {
+        return intern(name.data(), static_cast<int>(name.size()));
+    }
+
+    // Same for the characters [name, name + length), e.g. a token in a read
+    // buffer; a string is only built the first time the name is seen
+    int intern(const char *name, int length)
+    {
+        lock_guard<mutex> guard(lock);
+        unsigned int hash = HashTable<int>::hashOf(name, length);
+        int id = find(name, length, hash);
+        if (id != -1)
+        {
+            return id;
+        }
+        if (count % BLOCK_SIZE == 0)
+        {
+            blocks[count / BLOCK_SIZE] = new string[BLOCK_SIZE];
+        }
+        id = count++;
+        blocks[id / BLOCK_SIZE][id % BLOCK_SIZE].assign(name, length);
+        if (count * 2 > slotCount)
+        {
+            resize(slotCount * 2);
+        }
+        place(hash, id);
+        return id;
+    }
+
+    // ID of name, or -1 if it was never interned
+    int lookup(const string &name) const
+    {
+        lock_guard<mutex> guard(lock);
+        int length = static_cast<int>(name.size());
+        return find(name.data(), length, HashTable<int>::hashOf(name.data(), length));
+    }
+
+    const string &getName(int id) const
+    {
+        return blocks[id / BLOCK_SIZE][id % BLOCK_SIZE];
+    }
+
+    int getCount() const
+    {
+        lock_guard<mutex> guard(lock);
+        return count;
+    }
+};
+
+// Interned name: one int instead of a string, compared by ID. Converts to
+// const string & wherever a string is expected, so display code is
+// unchanged; the characters are only looked at when printed.
+class Symbol
+{
+private:
+    int id;
+
+public:
+    Symbol() : id(0) {}
+    Symbol(const string &name) : id(SymbolTable::global().intern(name)) {}
+    Symbol(const char *name) : id(SymbolTable::global().intern(name)) {}
+    Symbol(const char *name, int length) : id(SymbolTable::global().intern(name, length)) {}
+
+    int getId() const { return id; }
+    const string &str() const { return SymbolTable::global().getName(id); }
+    operator const string &() const { return str(); }
+    bool empty() const { return id == 0; }
+
+    bool operator==(const Symbol &other) const { return id == other.id; }
+    bool operator!=(const Symbol &other) const { return id != other.id; }
+};
+
+// Mixed comparisons look the characters up instead of interning the string
+inline bool operator==(const Symbol &a, const string &b) { return a.str() == b; }
+inline bool operator==(const string &a, const Symbol &b) { return a == b.str(); }
+inline bool operator==(const Symbol &a, const char *b) { return a.str() == b; }
+inline bool operator==(const char *a, const Symbol &b) { return a == b.str(); }
+inline bool operator!=(const Symbol &a, const string &b) { return a.str() != b; }
+inline bool operator!=(const string &a, const Symbol &b) { return a != b.str(); }
+inline bool operator!=(const Symbol &a, const char *b) { return a.str() != b; }
+inline bool operator!=(const char *a, const Symbol &b) { return a != b.str(); }
+
+inline string operator+(const string &a, const Symbol &b) { return a + b.str(); }
+inline string operator+(const Symbol &a, const string &b) { return a.str() + b; }
+inline string operator+(const char *a, const Symbol &b) { return a + b.str(); }
+inline string operator+(const Symbol &a, const char *b) { return a.str() + b; }
+
+inline ostream &operator<<(ostream &out, const Symbol &symbol)
+{
+    return out << symbol.str();
+}
+#endif
@@ -0,0 +1,346 @@
+#pragma once
+#ifndef TIME_DEPENDENT_ROUTER_H
+#define TIME_DEPENDENT_ROUTER_H
+
+#include "PathFinder.h"
+#include "IndexedMinHeap.h"
+#include "SearchWorkspace.h"
+#include <limits>
+using namespace std;
+// Time-dependent routing over the graph's sorted departure slices.
+//
+// Earliest arrival is Dijkstra over ports keyed by arrival time: a ship can
+// always wait for a later sailing, so the first time a port is settled is the
+// earliest it can be reached.
+//
+// Cheapest-by-deadline is Dijkstra over a time-expanded graph with one node
+// per sailing, so a port can be reached at several times with different
+// costs and a cheaper-but-later arrival never overwrites a feasible earlier
+// one. Waiting is a chain through the port's departures in time order:
+// landing enters it at the first departure after the arrival, and a waiting
+// ship either boards that departure or waits for the next, so every node has
+// at most two successors instead of an arc to each later departure. The
+// port charge grows with the time since landing, so each landing walks its
+// own chain, a batch of departures at a time.
+//
+// Both searches are goal-directed (A*): the frontier is ordered by the label
+// plus the graph's precomputed lower bound (shortest time at sea, cheapest
+// sailing costs) to the destination. The bounds are consistent, so the
+// answers are the same as plain Dijkstra with far fewer nodes settled, and
+// nodes that cannot reach the destination at all are never queued.
+//
+// Both searches record the sailing used to reach each node, so the path is
+// read back directly instead of re-querying the graph.
+class TimeDependentRouter
+{
+private:
+    Graph *graph;
+    SearchWorkspace workspace; // Search arrays reused across queries
+
+    // Departures a wait walk passes before it queues a dearer stretch
+    // instead of walking on; short waits at quiet ports stay off the heap
+    static const int WAIT_WALK_BATCH = 32;
+
+    // A sailing is worth queueing only if the destination is still reachable
+    // from where it lands, and not hopelessly late even at sea the whole way
+    static bool canFinishBy(const ReachabilityIndex &bounds, const Graph::Edge &edge, int destIdx, int deadline)
+    {
+        if (edge.destination == -1 || edge.arrival > deadline)
+            return false;
+        int remaining = bounds.getLowerBoundDuration(edge.destination, destIdx);
+        return remaining != ReachabilityIndex::UNREACHABLE && remaining <= deadline - edge.arrival;
+    }
+
+public:
+    TimeDependentRouter(Graph *g) : graph(g) {}
+
+    // Search a different graph from the next query on (schedule reload)
+    void setGraph(Graph *g) { graph = g; }
+
+    // Port charge for a layover (only charged above 12 hours)
+    static int layoverCharge(const Port &port, int layoverHours)
+    {
+        if (layoverHours <= 12)
+            return 0;
+        int days = (layoverHours + 11) / 24; // Round up to nearest day
+        if (days == 0)
+            days = 1; // At least 1 day for layover > 12 hours
+        return port.dailyCharge * days;
+    }
+
+    // Shortest layover, in whole hours, charged more than one of layoverHours
+    static int nextChargeHours(int layoverHours)
+    {
+        if (layoverHours <= 12)
+            return 13;
+        return layoverHours + 24 - (layoverHours - 13) % 24;
+    }
+
+    // Fill result from the sailings (route indices) taken, in order.
+    // Shared with ConnectionScanner.
+    static void buildResult(const Graph &graph, const string &origin,
+                            const ArrayList<int> &routeChain, PathResult &result)
+    {
+        result.found = true;
+        result.totalCost = 0;
+        result.path.push_back(origin);
+
+        for (int i = 0; i < routeChain.getSize(); i++)
+        {
+            const Route &route = graph.getRouteByIndex(routeChain.get(i));
+
+            if (result.routes.getSize() > 0)
+            {
+                const Route &arrivingRoute = result.routes.get(result.routes.getSize() - 1);
+                int layoverHours = Route::calculateLayoverHours(arrivingRoute, route);
+                int portCharge = 0;
+                int portId = graph.getPortId(route.origin);
+                if (portId != -1)
+                {
+                    portCharge = layoverCharge(graph.getPortById(portId), layoverHours);
+                }
+                result.layovers.push_back(LayoverInfo(route.origin, layoverHours, portCharge,
+                                                      Route::dateFromTimestamp(arrivingRoute.arrivalStamp), arrivingRoute.arrivalTime,
+                                                      route.date, route.departureTime));
+                result.totalCost += portCharge;
+            }
+
+            result.routes.push_back(route);
+            result.path.push_back(route.destination);
+            result.totalCost += route.cost;
+        }
+
+        if (result.routes.getSize() > 0)
+        {
+            result.totalTravelTime = (result.routes.get(result.routes.getSize() - 1).arrivalStamp -
+                                      result.routes.get(0).departureStamp) / 60;
+        }
+    }
+
+    // Earliest arrival at destination leaving origin at or after departAfter
+    PathResult findEarliestArrival(const string &origin, const string &destination, int departAfter)
+    {
+        PathResult result;
+
+        int originIdx = graph->getPortId(origin);
+        int destIdx = graph->getPortId(destination);
+        if (originIdx == -1 || destIdx == -1)
+        {
+            return result;
+        }
+
+        int numPorts = graph->getVertexCount();
+        StampedArray<int> &arrival = workspace.ints(0, numPorts, numeric_limits<int>::max());
+        StampedArray<int> &parentEdge = workspace.ints(1, numPorts, -1); // Sailing that reached each port
+        StampedArray<int> &parentPort = workspace.ints(2, numPorts, -1);
+        StampedArray<bool> &settled = workspace.flags(0, numPorts);
+
+        const ReachabilityIndex &bounds = graph->getReachability();
+        IndexedMinHeap<int> &frontier = workspace.frontier(0, numPorts);
+        if (bounds.canReach(originIdx, destIdx))
+        {
+            arrival[originIdx] = departAfter;
+            frontier.pushOrDecrease(originIdx, departAfter + bounds.getLowerBoundDuration(originIdx, destIdx));
+        }
+
+        int portIdx, estimate;
+        while (frontier.extractMin(portIdx, estimate))
+        {
+            settled[portIdx] = true;
+            if (portIdx == destIdx)
+            {
+                break;
+            }
+
+            Graph::EdgeRange departures = graph->getDeparturesAfter(portIdx, arrival[portIdx]);
+            for (const Graph::Edge *edge = departures.begin(); edge != departures.end(); edge++)
+            {
+                int next = edge->destination;
+                if (next == -1 || settled[next] || edge->arrival >= arrival[next])
+                    continue;
+                int remaining = bounds.getLowerBoundDuration(next, destIdx);
+                if (remaining == ReachabilityIndex::UNREACHABLE)
+                    continue;
+
+                arrival[next] = edge->arrival;
+                parentEdge[next] = graph->getEdgeIndex(edge);
+                parentPort[next] = portIdx;
+                frontier.pushOrDecrease(next, edge->arrival + remaining);
+            }
+        }
+
+        if (settled[destIdx])
+        {
+            ArrayList<int> chain;
+            int current = destIdx;
+            while (parentEdge[current] != -1)
+            {
+                chain.push_back(graph->getEdge(parentEdge[current]).routeIndex);
+                current = parentPort[current];
+            }
+            chain.reverse();
+            buildResult(*graph, origin, chain, result);
+        }
+
+        return result;
+    }
+
+    PathResult findEarliestArrival(const string &origin, const string &destination, const string &date)
+    {
+        return findEarliestArrival(origin, destination, Route::toTimestamp(date, "00:00"));
+    }
+
+    // Cheapest route (sailing costs plus port charges for layovers > 12h)
+    // leaving origin at or after departAfter and arriving by deadline
+    PathResult findCheapestByDeadline(const string &origin, const string &destination,
+                                      int departAfter, int deadline)
+    {
+        PathResult result;
+
+        int originIdx = graph->getPortId(origin);
+        int destIdx = graph->getPortId(destination);
+        if (originIdx == -1 || destIdx == -1)
+        {
+            return result;
+        }
+        if (originIdx == destIdx)
+        {
+            result.found = true;
+            result.path.push_back(origin);
+            return result;
+        }
+
+        int numSailings = graph->getRouteCount();
+        StampedArray<int> &cost = workspace.ints(0, numSailings, numeric_limits<int>::max());
+        StampedArray<int> &parentEdge = workspace.ints(1, numSailings, -1); // Previous sailing in the cheapest chain
+        StampedArray<int> &waitingFor = workspace.ints(2, numSailings, -1); // Departure a landed ship waits for
+        StampedArray<bool> &settled = workspace.flags(0, numSailings);
+
+        // Keys below numSailings are sailings; numSailings + s is the ship
+        // that landed by sailing s, waiting in port
+        const ReachabilityIndex &bounds = graph->getReachability();
+        IndexedMinHeap<int> &frontier = workspace.frontier(0, 2 * numSailings);
+
+        // Cheapest voyage to the destination queued so far; nothing dearer
+        // needs queueing, as it would never be taken out before that one
+        int bestQueued = numeric_limits<int>::max();
+        auto queueSailing = [&](int edgeIndex, int newCost, int parent) {
+            const Graph::Edge &edge = graph->getEdge(edgeIndex);
+            int key = newCost + bounds.getLowerBoundCost(edge.destination, destIdx);
+            if (key > bestQueued)
+                return;
+            if (edge.destination == destIdx)
+                bestQueued = newCost;
+            cost[edgeIndex] = newCost;
+            parentEdge[edgeIndex] = parent;
+            frontier.pushOrDecrease(edgeIndex, key);
+        };
+
+        // Any sailing out of the origin can start the voyage (no port charge at origin)
+        Graph::EdgeRange firstLegs = graph->getDeparturesAfter(originIdx, departAfter);
+        for (const Graph::Edge *edge = firstLegs.begin(); edge != firstLegs.end(); edge++)
+        {
+            if (edge->departure > deadline)
+                break; // Slice is sorted by departure
+            if (!canFinishBy(bounds, *edge, destIdx, deadline))
+                continue;
+
+            queueSailing(graph->getEdgeIndex(edge), edge->cost, -1);
+        }
+
+        // Walk the wait chain of the ship that landed by sailing `landed` from
+        // departure `next`, boarding each departure (the wait arcs cost only
+        // the port charge). Past a batch of departures, the wait for the
+        // first one that costs another day is queued at that charge instead,
+        // so it is walked on only if nothing cheaper comes first. The walk
+        // ends at the last departure the deadline allows
+        auto walkWait = [&](int landed, int next) {
+            const Graph::Edge &arrival = graph->getEdge(landed);
+            int port = arrival.destination;
+            int end = graph->getEdgeEnd(port);
+            if (next >= end)
+                return;
+            const Port &layoverPort = graph->getPortById(port);
+            int latestDeparture = deadline - bounds.getLowerBoundDuration(port, destIdx);
+            const Graph::Edge *edge = &graph->getEdge(next);
+            const Graph::Edge *last = &graph->getEdge(end - 1);
+            int layoverHours = (edge->departure - arrival.arrival) / 60;
+            int charge = layoverCharge(layoverPort, layoverHours);
+            int dearer = arrival.arrival + nextChargeHours(layoverHours) * 60; // Departures from here on cost more
+            for (int walked = 0; edge <= last && edge->departure <= latestDeparture; edge++, walked++)
+            {
+                int nextIndex = graph->getEdgeIndex(edge);
+                if (edge->departure >= dearer)
+                {
+                    layoverHours = (edge->departure - arrival.arrival) / 60;
+                    charge = layoverCharge(layoverPort, layoverHours);
+                    dearer = arrival.arrival + nextChargeHours(layoverHours) * 60;
+                    if (walked >= WAIT_WALK_BATCH)
+                    {
+                        int key = cost[landed] + charge + bounds.getLowerBoundCost(port, destIdx);
+                        if (key <= bestQueued)
+                        {
+                            waitingFor[landed] = nextIndex;
+                            frontier.pushOrDecrease(numSailings + landed, key);
+                        }
+                        return;
+                    }
+                }
+                if (settled[nextIndex] || !canFinishBy(bounds, *edge, destIdx, deadline))
+                    continue;
+
+                int newCost = cost[landed] + charge + edge->cost;
+                if (newCost < cost[nextIndex])
+                {
+                    queueSailing(nextIndex, newCost, landed);
+                }
+            }
+        };
+
+        int lastEdge = -1;
+        int node, estimate;
+        while (frontier.extractMin(node, estimate))
+        {
+            if (node >= numSailings)
+            {
+                int landed = node - numSailings;
+                walkWait(landed, waitingFor[landed]);
+                continue;
+            }
+
+            settled[node] = true;
+            const Graph::Edge &sailing = graph->getEdge(node);
+            if (sailing.destination == destIdx)
+            {
+                lastEdge = node;
+                break;
+            }
+
+            Graph::EdgeRange departures = graph->getDeparturesAfter(sailing.destination, sailing.arrival);
+            walkWait(node, graph->getEdgeIndex(departures.begin()));
+        }
+
+        if (lastEdge != -1)
+        {
+            ArrayList<int> chain;
+            for (int e = lastEdge; e != -1; e = parentEdge[e])
+            {
+                chain.push_back(graph->getEdge(e).routeIndex);
+            }
+            chain.reverse();
+            buildResult(*graph, origin, chain, result);
+        }
+
+        return result;
+    }
+
+    PathResult findCheapestByDeadline(const string &origin, const string &destination,
+                                      const string &date, const string &deadlineDate,
+                                      const string &deadlineTime)
+    {
+        return findCheapestByDeadline(origin, destination, Route::toTimestamp(date, "00:00"),
+                                      Route::toTimestamp(deadlineDate, deadlineTime));
+    }
+};
+
+#endif
@@ -2,14 +2,17 @@
 #include <SFML/Graphics.hpp>
 #include "Graph.h"
 #include "RouteParser.h"
+#include "ScheduleReloader.h"
 #include "MapVisualizer.h"
 #include "PathFinder.h"
 #include "ShortestPathFinder.h"
+#include "ParetoPathFinder.h"
 #include "InputHandler.h"
 #include "BookingVisualizer.h"
 #include "PreferenceInputHandler.h"
 #include "PreferenceFilter.h"
 #include "LinkedList.h"
+#include "ArrayList.h"
 #include <iostream>
 #include <sstream>
 using namespace std;
@@ -97,21 +100,24 @@ int main()
 
     // Build the graph
     cout << "Loading maritime data..." << endl;
-    Graph maritimeGraph;
-    RouteParser::buildGraphFromFile(maritimeGraph, "Routes.txt", "PortCharges.txt");
+    // The reloader watches the data files and publishes a rebuilt graph when
+    // they change; the UI adopts it between frames (see the main loop)
+    ScheduleReloader scheduleReloader("Routes.txt", "PortCharges.txt", "Routes.snap");
+    shared_ptr<Graph> graphSnapshot = scheduleReloader.acquire();
+    Graph *maritimeGraph = graphSnapshot.get();
 
     cout << "Graph loaded successfully!" << endl;
-    cout << "Total Ports: " << maritimeGraph.getVertexCount() << endl;
-    cout << "Total Routes: " << maritimeGraph.getAllRoutes().getSize() << endl;
+    cout << "Total Ports: " << maritimeGraph->getVertexCount() << endl;
+    cout << "Total Routes: " << maritimeGraph->getAllRoutes().getSize() << endl;
 
     // Create visualizers and utilities
-    MapVisualizer mapVisualizer(&maritimeGraph, &font);
+    MapVisualizer mapVisualizer(maritimeGraph, &font);
     if (!mapVisualizer.loadMapBackground("Images/maps.png"))
     {
         cout << "Warning: map image not found. Using default background." << endl;
     }
 
-    BookingVisualizer bookingVisualizer(&maritimeGraph, &font);
+    BookingVisualizer bookingVisualizer(maritimeGraph, &font);
 
     // Load map for BookingVisualizer
     if (!bookingVisualizer.loadMapBackground("Images/maps.png"))
@@ -127,8 +133,9 @@ int main()
     PreferenceInputHandler preferenceInput;
 
     // Pathfinders
-    PathFinder pathFinder(&maritimeGraph);
-    ShortestPathFinder shortestPathFinder(&maritimeGraph); // NEW: For shortest path queries
+    PathFinder pathFinder(maritimeGraph);
+    ShortestPathFinder shortestPathFinder(maritimeGraph); // NEW: For shortest path queries
+    ParetoPathFinder paretoFinder(maritimeGraph);         // Cheapest and fewest-legs bookings in one search
 
     // Main menu state
     bool showMenu = true;
@@ -139,13 +146,13 @@ int main()
     string origin, destination, date;
     string errorMessage = "";
     PathResult currentPath;
-    LinkedList<LinkedList<string>> allPaths;
+    ArrayList<ArrayList<string>> allPaths;
     sf::Clock messageTimer;
     bool useBidirectional = false; // Option to use bidirectional search
     bool showStepByStep = false;   // Option to show step-by-step algorithm visualization
     int currentAlgorithmStep = 0;
-    LinkedList<string> currentVisitedPorts;
-    LinkedList<string> currentProcessingPorts;
+    ArrayList<string> currentVisitedPorts;
+    ArrayList<string> currentProcessingPorts;
     string currentProcessingPortName = "";
     bool useShortestPath = false; // NEW: Track if user chose shortest path
 
@@ -155,7 +162,7 @@ int main()
     string prefErrorMessage = "";
     PathResult prefCurrentPath;
     PreferenceFilter currentPreferences;
-    LinkedList<Route> prefConnectingRoutes;
+    ArrayList<Route> prefConnectingRoutes;
     sf::Clock prefMessageTimer;
     bool prefUseShortestPath = false; // NEW: Track if user chose shortest path for preferences
 
@@ -183,6 +190,23 @@ int main()
     // Main game loop
     while (window.isOpen())
     {
+        // Switch to a reloaded schedule; the old graph is released once
+        // nothing holds it, and ships waiting at ports stay in their queues
+        shared_ptr<Graph> latestGraph = scheduleReloader.acquire();
+        if (latestGraph != graphSnapshot)
+        {
+            latestGraph->copyDockingQueuesFrom(*graphSnapshot);
+            graphSnapshot = latestGraph;
+            maritimeGraph = graphSnapshot.get();
+            mapVisualizer.setGraph(maritimeGraph);
+            bookingVisualizer.setGraph(maritimeGraph);
+            pathFinder.setGraph(maritimeGraph);
+            shortestPathFinder.setGraph(maritimeGraph);
+            paretoFinder.setGraph(maritimeGraph);
+            cout << "Schedule reloaded: " << maritimeGraph->getVertexCount() << " ports, "
+                 << maritimeGraph->getRouteCount() << " routes" << endl;
+        }
+
         sf::Event event;
         while (window.pollEvent(event))
         {
@@ -442,7 +466,7 @@ int main()
                             if (dockingPortInput.getIsActive() && !dockingPortInput.getText().empty())
                             {
                                 selectedDockingPort = dockingPortInput.getText();
-                                if (!maritimeGraph.hasPort(selectedDockingPort))
+                                if (!maritimeGraph->hasPort(selectedDockingPort))
                                 {
                                     dockingErrorMessage = "Port '" + selectedDockingPort + "' not found!";
                                     dockingPortInput.clear();
@@ -456,7 +480,7 @@ int main()
                             else if (dockingShipInput.getIsActive() && !dockingShipInput.getText().empty())
                             {
                                 string shipName = dockingShipInput.getText();
-                                maritimeGraph.addShipToQueue(selectedDockingPort, shipName);
+                                maritimeGraph->addShipToQueue(selectedDockingPort, shipName);
                                 cout << "Added ship '" << shipName << "' to queue at " << selectedDockingPort << endl;
                                 dockingShipInput.clear();
                                 dockingShipInput.deactivate();
@@ -469,17 +493,17 @@ int main()
                             if (!dockingPortInput.getText().empty())
                             {
                                 string portName = dockingPortInput.getText();
-                                if (!maritimeGraph.hasPort(portName))
+                                if (!maritimeGraph->hasPort(portName))
                                 {
                                     dockingErrorMessage = "Port '" + portName + "' not found!";
                                 }
-                                else if (maritimeGraph.getQueueSize(portName) == 0)
+                                else if (maritimeGraph->getQueueSize(portName) == 0)
                                 {
                                     dockingErrorMessage = "No ships in queue at " + portName + "!";
                                 }
                                 else
                                 {
-                                    bool removed = maritimeGraph.removeShipFromQueue(portName);
+                                    bool removed = maritimeGraph->removeShipFromQueue(portName);
                                     if (removed)
                                     {
                                         cout << "Removed ship from queue at " << portName << endl;
@@ -496,7 +520,7 @@ int main()
                             if (!dockingPortInput.getText().empty())
                             {
                                 selectedDockingPort = dockingPortInput.getText();
-                                if (!maritimeGraph.hasPort(selectedDockingPort))
+                                if (!maritimeGraph->hasPort(selectedDockingPort))
                                 {
                                     dockingErrorMessage = "Port '" + selectedDockingPort + "' not found!";
                                     dockingPortInput.clear();
@@ -769,7 +793,7 @@ int main()
             {
                 errorMessage = "";
 
-                if (!maritimeGraph.hasPort(origin))
+                if (!maritimeGraph->hasPort(origin))
                 {
                     errorMessage = "Error: Origin port '" + origin + "' not found!";
                     cout << errorMessage << endl;
@@ -777,7 +801,7 @@ int main()
                     originInput.clear();
                     originInput.activate();
                 }
-                else if (!maritimeGraph.hasPort(destination))
+                else if (!maritimeGraph->hasPort(destination))
                 {
                     errorMessage = "Error: Destination port '" + destination + "' not found!";
                     cout << errorMessage << endl;
@@ -797,7 +821,7 @@ int main()
                 cout << "Finding all possible paths..." << endl;
                 allPaths = pathFinder.findAllPaths(origin, destination, date);
 
-                LinkedList<Route> connectingRoutes =
+                ArrayList<Route> connectingRoutes =
                     pathFinder.getAllConnectingRoutes(origin, destination, date);
                 bookingVisualizer.showConnectingRoutes(origin, destination, connectingRoutes, date);
 
@@ -843,7 +867,7 @@ int main()
                     else if (currentAlgorithmStep <= 5)
                     {
                         // Simulate processing neighbors
-                        LinkedList<Route> routes = maritimeGraph.getRoutesFromOnDate(currentProcessingPortName, date);
+                        Graph::RouteView routes = maritimeGraph->getRoutesFromOnDate(currentProcessingPortName, date);
                         if (routes.getSize() > 0 && currentAlgorithmStep < routes.getSize() + 2)
                         {
                             currentProcessingPorts.push_back(routes.get(currentAlgorithmStep - 2).destination);
@@ -862,25 +886,31 @@ int main()
             }
             else if (bookingState == CALCULATING_OPTIMAL)
             {
-                // Use appropriate pathfinder based on user's choice
-                if (useShortestPath)
+                // Use bidirectional search if enabled for cheapest path
+                if (!useShortestPath && useBidirectional)
                 {
-                    cout << "Finding SHORTEST path using Dijkstra..." << endl;
-                    currentPath = shortestPathFinder.findShortestPath(origin, destination, date);
+                    cout << "Finding CHEAPEST path using Bidirectional Dijkstra..." << endl;
+                    currentPath = pathFinder.findCheapestPathBidirectional(origin, destination, date);
                 }
                 else
                 {
-                    // Use bidirectional search if enabled for cheapest path
-                    if (useBidirectional)
-                    {
-                        cout << "Finding CHEAPEST path using Bidirectional Dijkstra..." << endl;
-                        currentPath = pathFinder.findCheapestPathBidirectional(origin, destination, date);
-                    }
-                    else
-                    {
-                        cout << "Finding CHEAPEST path using Dijkstra..." << endl;
-                        currentPath = pathFinder.findCheapestPath(origin, destination, date);
+                    // One Pareto search gives the cheapest voyage, the one with
+                    // the fewest legs and the trade-offs in between
+                    cout << "Finding voyage options (cost / arrival / legs) using Pareto search..." << endl;
+                    ArrayList<PathResult> options = paretoFinder.findParetoPaths(origin, destination, date);
+                    int chosen = options.getSize() > 0 ? 0 : -1; // Cheapest comes first
+                    for (int i = 0; i < options.getSize(); i++)
+                    {
+                        const PathResult &option = options.get(i);
+                        cout << "  Option " << (i + 1) << ": $" << option.totalCost << ", "
+                             << option.totalTravelTime << " hours, " << option.routes.getSize() << " legs" << endl;
+                        if (useShortestPath && option.routes.getSize() < options.get(chosen).routes.getSize())
+                        {
+                            chosen = i;
+                        }
                     }
+                    currentPath = chosen != -1 ? options.get(chosen) : PathResult();
+                    cout << "Selected the " << (useShortestPath ? "SHORTEST" : "CHEAPEST") << " option" << endl;
                 }
 
                 if (currentPath.found)
@@ -923,7 +953,7 @@ int main()
             {
                 multiErrorMessage = "";
 
-                if (!maritimeGraph.hasPort(multiOrigin))
+                if (!maritimeGraph->hasPort(multiOrigin))
                 {
                     multiErrorMessage = "Error: Origin port '" + multiOrigin + "' not found!";
                     cout << multiErrorMessage << endl;
@@ -931,7 +961,7 @@ int main()
                     multiPortInput.clear();
                     multiPortInput.activate();
                 }
-                else if (!maritimeGraph.hasPort(multiDestination))
+                else if (!maritimeGraph->hasPort(multiDestination))
                 {
                     multiErrorMessage = "Error: Destination port '" + multiDestination + "' not found!";
                     cout << multiErrorMessage << endl;
@@ -945,7 +975,7 @@ int main()
                     bool allValid = true;
                     for (int i = 0; i < intermediatePorts.getSize(); i++)
                     {
-                        if (!maritimeGraph.hasPort(intermediatePorts.get(i)))
+                        if (!maritimeGraph->hasPort(intermediatePorts.get(i)))
                         {
                             multiErrorMessage = "Error: Intermediate port '" + intermediatePorts.get(i) + "' not found!";
                             cout << multiErrorMessage << endl;
@@ -977,7 +1007,7 @@ int main()
                     cout << "Multi-leg route found! Total cost: $" << multiLegPath.totalCost << endl;
 
                     // Show all routes on map with multi-leg route highlighted
-                    LinkedList<Route> allConnectingRoutes;
+                    ArrayList<Route> allConnectingRoutes;
                     for (int i = 0; i < multiLegPath.routes.getSize(); i++)
                     {
                         allConnectingRoutes.push_back(multiLegPath.routes.get(i));
@@ -990,7 +1020,7 @@ int main()
                 {
                     cout << "No complete multi-leg route found!" << endl;
                     // Still show map with all routes
-                    LinkedList<Route> emptyRoutes;
+                    ArrayList<Route> emptyRoutes;
                     bookingVisualizer.showConnectingRoutes(multiOrigin, multiDestination, emptyRoutes, multiDate);
                     multiLegState = MULTI_SHOWING_ROUTE;
                     multiLegPath.totalCost = 0;
@@ -1013,7 +1043,7 @@ int main()
             {
                 prefErrorMessage = "";
 
-                if (!maritimeGraph.hasPort(prefOrigin))
+                if (!maritimeGraph->hasPort(prefOrigin))
                 {
                     prefErrorMessage = "Error: Origin port '" + prefOrigin + "' not found!";
                     cout << prefErrorMessage << endl;
@@ -1021,7 +1051,7 @@ int main()
                     originInput.clear();
                     originInput.activate();
                 }
-                else if (!maritimeGraph.hasPort(prefDestination))
+                else if (!maritimeGraph->hasPort(prefDestination))
                 {
                     prefErrorMessage = "Error: Destination port '" + prefDestination + "' not found!";
                     cout << prefErrorMessage << endl;
@@ -1058,9 +1088,9 @@ int main()
                 }
                 else
                 {
-                    cout << "Calculating CHEAPEST path with preferences using Dijkstra..." << endl;
+                    cout << "Calculating CHEAPEST path with preferences using A*..." << endl;
                     prefCurrentPath = pathFinder.findCheapestPathWithPreferences(
-                        prefOrigin, prefDestination, prefDate, currentPreferences);
+                        prefOrigin, prefDestination, prefDate, currentPreferences, true);
                 }
 
                 if (prefCurrentPath.found)
@@ -2270,7 +2300,7 @@ int main()
                     sectionTitle.setPosition(60, 290);
                     window.draw(sectionTitle);
 
-                    LinkedList<Port> allPorts = maritimeGraph.getAllPorts();
+                    ArrayList<Port> allPorts = maritimeGraph->getAllPorts();
                     float yPos = 330;
                     int portsWithShips = 0;
                     int totalShips = 0;
@@ -2279,7 +2309,7 @@ int main()
                     for (int i = 0; i < allPorts.getSize(); i++)
                     {
                         const Port &port = allPorts.get(i);
-                        int queueSize = maritimeGraph.getQueueSize(port.name);
+                        int queueSize = maritimeGraph->getQueueSize(port.name);
 
                         if (queueSize > 0)
                         {
@@ -2295,7 +2325,7 @@ int main()
                             window.draw(portText);
 
                             // Show ships in queue
-                            LinkedList<string> ships = maritimeGraph.getQueueShips(port.name);
+                            ArrayList<string> ships = maritimeGraph->getQueueShips(port.name);
                             stringstream shipsList;
                             shipsList << "  Ships: ";
                             for (int j = 0; j < ships.getSize(); j++)
@@ -2426,7 +2456,7 @@ int main()
                     else if (!selectedDockingPort.empty())
                     {
                         Port port;
-                        if (maritimeGraph.getPort(selectedDockingPort, port))
+                        if (maritimeGraph->getPort(selectedDockingPort, port))
                         {
                             // Port information
                             stringstream portInfo;
@@ -2434,13 +2464,13 @@ int main()
                                      << "Location: (" << port.x << ", " << port.y << ")\n"
                                      << "Daily Charge: $" << port.dailyCharge << "\n\n";
 
-                            int queueSize = maritimeGraph.getQueueSize(port.name);
+                            int queueSize = maritimeGraph->getQueueSize(port.name);
                             portInfo << "Docking Queue:\n"
                                      << "  Ships Waiting: " << queueSize << "\n";
 
                             if (queueSize > 0)
                             {
-                                LinkedList<string> ships = maritimeGraph.getQueueShips(port.name);
+                                ArrayList<string> ships = maritimeGraph->getQueueShips(port.name);
                                 portInfo << "  Ships in Queue:\n";
                                 for (int i = 0; i < ships.getSize(); i++)
                                 {
@@ -2453,7 +2483,7 @@ int main()
                             }
 
                             // Get routes from this port
-                            LinkedList<Route> routes = maritimeGraph.getRoutesFrom(port.name);
+                            Graph::RouteView routes = maritimeGraph->getRoutesFrom(port.name);
                             portInfo << "\nRoutes from this port: " << routes.getSize();
 
                             sf::Text portText(portInfo.str(), font, 14);